@@ -0,0 +1,411 @@
+#ifndef BIT_ARRAY_HPP
+#define BIT_ARRAY_HPP
+
+#include "dyn_array.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <bit>
+#include <iostream>
+
+/**
+ * Personal implementation of a dynamic bitset, as a compact alternative to DynArray<bool> that
+ * uses a single bit per flag. The bits are stored in a DynArray of 64 bits words, so it grows with
+ * the same machinery as any other DynArray.
+ * Counting, searching and the bulk operations between BitArrays work a whole word at a time, and
+ * the bulk operations are plain loops over contiguous words so the compiler can vectorize them.
+ * The bits past size() in the last word are always 0, so they never have to be masked when reading.
+*/
+
+namespace hdsa
+{
+
+class BitArray final
+{
+public:
+    using word_type = std::uint64_t;
+
+    static constexpr std::size_t bits_per_word { 64 };
+
+    // Returned by find_first() and find_next() when there are no more bits set
+    static constexpr std::size_t npos { static_cast<std::size_t>(-1) };
+
+private:
+    SilentDynArray<word_type> m_words {};
+    std::size_t m_size {};
+
+    static std::size_t words_for(std::size_t bit_amount) noexcept
+    {
+        return (bit_amount + bits_per_word - 1) / bits_per_word;
+    }
+
+    static word_type mask_of(std::size_t position) noexcept
+    {
+        return (word_type { 1 } << (position % bits_per_word));
+    }
+
+    // It sets to 0 the bits of the last word that are past size()
+    void clear_unused_bits() noexcept
+    {
+        std::size_t used_bits { m_size % bits_per_word };
+
+        if (used_bits != 0)
+        {
+            m_words[m_words.size() - 1] &= (word_type { 1 } << used_bits) - 1;
+        }
+    }
+
+public:
+    BitArray() = default;
+
+    // It creates a BitArray with "size" bits, all of them set to "value"
+    explicit BitArray(std::size_t size, bool value = false)
+    {
+        resize(size, value);
+    }
+
+    std::size_t size() const noexcept { return m_size; }
+
+    std::size_t capacity() const noexcept { return m_words.capacity() * bits_per_word; }
+
+    bool is_empty() const noexcept { return (m_size == 0); }
+
+    std::size_t word_count() const noexcept { return m_words.size(); }
+
+    word_type* words() noexcept { return m_words.data(); }
+
+    const word_type* words() const noexcept { return m_words.data(); }
+
+    void reserve_memory(std::size_t bit_amount)
+    {
+        std::size_t word_amount { words_for(bit_amount) };
+
+        if (word_amount > m_words.capacity())
+        {
+            m_words.reserve_memory(word_amount);
+        }
+    }
+
+    bool operator[](std::size_t position) const noexcept
+    {
+        return ((m_words[position / bits_per_word] & mask_of(position)) != 0);
+    }
+
+    // It works the same as operator[] but it has bounds checking
+    bool test(std::size_t position) const
+    {
+        BASIC_ASSERT((position < m_size), "The position must be a positive number and not bigger than the size of the BitArray.\n");
+
+        return (*this)[position];
+    }
+
+    void set(std::size_t position) noexcept
+    {
+        m_words[position / bits_per_word] |= mask_of(position);
+    }
+
+    void set(std::size_t position, bool value) noexcept
+    {
+        word_type& word { m_words[position / bits_per_word] };
+
+        // Branchless, so random patterns of values don't cause mispredictions
+        word = (word & ~mask_of(position)) | (static_cast<word_type>(value) << (position % bits_per_word));
+    }
+
+    void reset(std::size_t position) noexcept
+    {
+        m_words[position / bits_per_word] &= ~mask_of(position);
+    }
+
+    void flip(std::size_t position) noexcept
+    {
+        m_words[position / bits_per_word] ^= mask_of(position);
+    }
+
+    // The versions without arguments work on every bit
+    void set() noexcept
+    {
+        for (word_type& word : m_words)
+        {
+            word = ~word_type {};
+        }
+
+        clear_unused_bits();
+    }
+
+    void reset() noexcept
+    {
+        for (word_type& word : m_words)
+        {
+            word = 0;
+        }
+    }
+
+    void flip() noexcept
+    {
+        for (word_type& word : m_words)
+        {
+            word = ~word;
+        }
+
+        clear_unused_bits();
+    }
+
+    void push_back(bool value)
+    {
+        if ((m_size % bits_per_word) == 0)
+        {
+            m_words.push_back(0);
+        }
+
+        m_words[m_words.size() - 1] |= (static_cast<word_type>(value) << (m_size % bits_per_word));
+        m_size++;
+    }
+
+    void pop_back()
+    {
+        if (is_empty())
+        {
+            std::cout << "The BitArray is already empty, no bits will be popped out.\n";
+            return;
+        }
+
+        m_size--;
+
+        if ((m_size % bits_per_word) == 0)
+        {
+            m_words.pop_back();
+        }
+        else
+        {
+            clear_unused_bits();
+        }
+    }
+
+    // Changes the size of the BitArray and sets the new bits to "value"
+    void resize(std::size_t bit_amount, bool value = false)
+    {
+        std::size_t old_size { m_size };
+        std::size_t word_amount { words_for(bit_amount) };
+
+        if (word_amount < m_words.size())
+        {
+            m_words.resize(word_amount);
+        }
+        else if (word_amount > m_words.size())
+        {
+            m_words.resize(word_amount, value ? ~word_type {} : word_type {});
+        }
+
+        m_size = bit_amount;
+
+        // The bits of the word that was the last one before growing aren't covered by the new words
+        if (value && (bit_amount > old_size) && ((old_size % bits_per_word) != 0))
+        {
+            m_words[old_size / bits_per_word] |= ~word_type {} << (old_size % bits_per_word);
+        }
+
+        clear_unused_bits();
+    }
+
+    void clear() noexcept
+    {
+        m_words.destroy_all();
+        m_size = 0;
+    }
+
+    // The amount of bits set to 1
+    std::size_t popcount() const noexcept
+    {
+        std::size_t count {};
+
+        for (word_type word : m_words)
+        {
+            count += static_cast<std::size_t>(std::popcount(word));
+        }
+
+        return count;
+    }
+
+    bool all() const noexcept { return (popcount() == m_size); }
+
+    bool any() const noexcept
+    {
+        for (word_type word : m_words)
+        {
+            if (word != 0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool none() const noexcept { return !any(); }
+
+    // The position of the first bit set to 1, or npos if there are none
+    std::size_t find_first() const noexcept
+    {
+        for (std::size_t i {}; i < m_words.size(); i++)
+        {
+            if (m_words[i] != 0)
+            {
+                return (i * bits_per_word) + static_cast<std::size_t>(std::countr_zero(m_words[i]));
+            }
+        }
+
+        return npos;
+    }
+
+    // The position of the first bit set to 1 after "position", or npos if there are none
+    std::size_t find_next(std::size_t position) const noexcept
+    {
+        position++;
+
+        if (position >= m_size)
+        {
+            return npos;
+        }
+
+        std::size_t i { position / bits_per_word };
+        word_type word { m_words[i] & (~word_type {} << (position % bits_per_word)) };
+
+        while (true)
+        {
+            if (word != 0)
+            {
+                return (i * bits_per_word) + static_cast<std::size_t>(std::countr_zero(word));
+            }
+
+            i++;
+
+            if (i == m_words.size())
+            {
+                return npos;
+            }
+
+            word = m_words[i];
+        }
+    }
+
+    // The bulk operations need both BitArrays to have the same size
+    BitArray& operator&=(const BitArray& other) noexcept
+    {
+        BASIC_ASSERT((m_size == other.m_size), "Both BitArrays must have the same size.\n");
+
+        word_type* a { m_words.data() };
+        const word_type* b { other.m_words.data() };
+
+        for (std::size_t i {}; i < m_words.size(); i++)
+        {
+            a[i] &= b[i];
+        }
+
+        return *this;
+    }
+
+    BitArray& operator|=(const BitArray& other) noexcept
+    {
+        BASIC_ASSERT((m_size == other.m_size), "Both BitArrays must have the same size.\n");
+
+        word_type* a { m_words.data() };
+        const word_type* b { other.m_words.data() };
+
+        for (std::size_t i {}; i < m_words.size(); i++)
+        {
+            a[i] |= b[i];
+        }
+
+        return *this;
+    }
+
+    BitArray& operator^=(const BitArray& other) noexcept
+    {
+        BASIC_ASSERT((m_size == other.m_size), "Both BitArrays must have the same size.\n");
+
+        word_type* a { m_words.data() };
+        const word_type* b { other.m_words.data() };
+
+        for (std::size_t i {}; i < m_words.size(); i++)
+        {
+            a[i] ^= b[i];
+        }
+
+        return *this;
+    }
+
+    // Clears every bit that is set in "other", AKA *this & ~other
+    BitArray& and_not(const BitArray& other) noexcept
+    {
+        BASIC_ASSERT((m_size == other.m_size), "Both BitArrays must have the same size.\n");
+
+        word_type* a { m_words.data() };
+        const word_type* b { other.m_words.data() };
+
+        for (std::size_t i {}; i < m_words.size(); i++)
+        {
+            a[i] &= ~b[i];
+        }
+
+        return *this;
+    }
+
+    // "a" is returned by name so it's moved out, returning (a &= b) would copy all its words
+    friend BitArray operator&(BitArray a, const BitArray& b)
+    {
+        a &= b;
+
+        return a;
+    }
+
+    friend BitArray operator|(BitArray a, const BitArray& b)
+    {
+        a |= b;
+
+        return a;
+    }
+
+    friend BitArray operator^(BitArray a, const BitArray& b)
+    {
+        a ^= b;
+
+        return a;
+    }
+
+    friend bool operator==(const BitArray& a, const BitArray& b) noexcept
+    {
+        if (a.m_size != b.m_size)
+        {
+            return false;
+        }
+
+        for (std::size_t i {}; i < a.m_words.size(); i++)
+        {
+            if (a.m_words[i] != b.m_words[i])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const BitArray& bits)
+    {
+        out << "BitArray { ";
+
+        for (std::size_t i {}; i < bits.size(); i++)
+        {
+            out << (bits[i] ? '1' : '0');
+        }
+
+        out << " }\n";
+
+        return out;
+    }
+};
+
+} // namespace hdsa end
+
+#endif // BIT_ARRAY_HPP
@@ -0,0 +1,351 @@
+#ifndef CHUNK_STREAM_HPP
+#define CHUNK_STREAM_HPP
+
+#include "dyn_array.hpp"
+#include "dyn_array_serialization.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * Streaming readers and writers that move data between a file descriptor (files, pipes, sockets)
+ * and a ring of reusable DynArray<char> buffers. A background I/O thread fills (or flushes) the
+ * next buffers while the caller processes the current one, so I/O and compute overlap and the
+ * memory used never goes beyond buffer_count * chunk_size bytes.
+ * All the buffers reserve their memory once at construction and never reallocate afterwards.
+ * It needs a POSIX system because it works with file descriptors.
+*/
+
+#if defined(__unix__) || defined(__APPLE__)
+
+namespace hdsa
+{
+
+enum class ChunkMode
+{
+    fixed_size, // Every chunk has exactly chunk_size bytes, except maybe the last one
+    delimited   // Every chunk ends right after a delimiter, so records are never split between chunks
+};
+
+class ChunkStream final
+{
+public:
+    // The I/O thread fills the buffers, so they never print anything
+    using buffer_type = SilentDynArray<char>;
+
+private:
+    int m_fd { -1 };
+    std::size_t m_chunk_size {};
+    ChunkMode m_mode { ChunkMode::fixed_size };
+    char m_delimiter { '\n' };
+
+    SilentDynArray<buffer_type> m_buffers {};
+    buffer_type m_carry {};          // Bytes after the last delimiter of a chunk, they start the next one
+
+    std::size_t m_filled {};         // Amount of chunks read by the I/O thread so far
+    std::size_t m_consumed {};       // Amount of chunks given back by the caller so far
+    bool m_holding { false };        // True while the caller is using the chunk returned by next()
+    bool m_finished { false };       // The I/O thread reached the end of the data or an error
+    bool m_stopping { false };
+
+    std::mutex m_mutex {};
+    std::condition_variable m_chunk_ready {};
+    std::condition_variable m_buffer_free {};
+    std::thread m_io_thread {};
+
+    // It reads the next chunk into "buffer" and returns false when there's nothing left to read
+    bool fill(buffer_type& buffer)
+    {
+        std::size_t carried { m_carry.size() };
+
+        buffer.resize_and_overwrite(m_chunk_size, [this, carried](char* data, std::size_t amount)
+        {
+            if (carried > 0)
+            {
+                std::memcpy(data, m_carry.data(), carried);
+            }
+
+            return carried + read_all(m_fd, data + carried, amount - carried);
+        });
+
+        m_carry.destroy_all();
+
+        if (buffer.is_empty())
+        {
+            return false;
+        }
+
+        // A short read means the data ended, so the last record is complete even without a delimiter
+        if ((m_mode == ChunkMode::delimited) && (buffer.size() == m_chunk_size))
+        {
+            const char* data { buffer.data() };
+            std::size_t end { buffer.size() };
+
+            while ((end > 0) && (data[end - 1] != m_delimiter))
+            {
+                end--;
+            }
+
+            // Records longer than a whole chunk can't be kept together, so they are split
+            if ((end > 0) && (end < buffer.size()))
+            {
+                std::size_t leftover { buffer.size() - end };
+
+                m_carry.resize_and_overwrite(leftover, [data, end](char* carry, std::size_t amount)
+                {
+                    std::memcpy(carry, data + end, amount);
+                    return amount;
+                });
+
+                buffer.resize_and_overwrite(end, [](char*, std::size_t amount) { return amount; });
+            }
+        }
+
+        return true;
+    }
+
+    void io_loop()
+    {
+        while (true)
+        {
+            buffer_type* buffer { nullptr };
+
+            {
+                std::unique_lock lock { m_mutex };
+                m_buffer_free.wait(lock, [this] { return m_stopping || ((m_filled - m_consumed) < m_buffers.size()); });
+
+                if (m_stopping)
+                {
+                    break;
+                }
+
+                buffer = &m_buffers[m_filled % m_buffers.size()];
+            }
+
+            bool has_data { fill(*buffer) };
+
+            {
+                std::lock_guard lock { m_mutex };
+
+                if (has_data)
+                {
+                    m_filled++;
+                }
+                else
+                {
+                    m_finished = true;
+                }
+            }
+
+            m_chunk_ready.notify_one();
+
+            if (!has_data)
+            {
+                break;
+            }
+        }
+    }
+
+public:
+    // The stream doesn't own "fd", so it has to be closed by the caller after the ChunkStream is destroyed
+    ChunkStream(int fd, std::size_t chunk_size, std::size_t buffer_count = 4, ChunkMode mode = ChunkMode::fixed_size, char delimiter = '\n')
+    : m_fd { fd },
+      m_chunk_size { chunk_size },
+      m_mode { mode },
+      m_delimiter { delimiter },
+      m_buffers(buffer_count)
+    {
+        BASIC_ASSERT((chunk_size > 0), "The size of the chunks must be bigger than 0.\n");
+        BASIC_ASSERT((buffer_count > 1), "At least 2 buffers are needed, so one can be read while the other one is processed.\n");
+
+        for (buffer_type& buffer : m_buffers)
+        {
+            buffer.reserve_memory(m_chunk_size);
+        }
+
+        m_carry.reserve_memory(m_chunk_size);
+
+        m_io_thread = std::thread { &ChunkStream::io_loop, this };
+    }
+
+    ChunkStream(const ChunkStream& other) = delete;
+    ChunkStream& operator=(const ChunkStream& other) = delete;
+
+    ~ChunkStream()
+    {
+        {
+            std::lock_guard lock { m_mutex };
+            m_stopping = true;
+        }
+
+        m_buffer_free.notify_one();
+        m_io_thread.join();
+    }
+
+    // It gives back the previous chunk and waits for the next one. It returns nullptr when there are no
+    // chunks left. The returned buffer is only valid until the next call
+    const buffer_type* next()
+    {
+        std::unique_lock lock { m_mutex };
+
+        if (m_holding)
+        {
+            m_consumed++;
+            m_holding = false;
+            m_buffer_free.notify_one();
+        }
+
+        m_chunk_ready.wait(lock, [this] { return m_finished || (m_filled > m_consumed); });
+
+        if (m_filled == m_consumed)
+        {
+            return nullptr;
+        }
+
+        m_holding = true;
+
+        return &m_buffers[m_consumed % m_buffers.size()];
+    }
+
+    std::size_t chunk_size() const noexcept { return m_chunk_size; }
+
+    std::size_t buffer_count() const noexcept { return m_buffers.size(); }
+};
+
+class ChunkStreamWriter final
+{
+public:
+    // Silent too, like the buffers of ChunkStream
+    using buffer_type = SilentDynArray<char>;
+
+private:
+    int m_fd { -1 };
+    std::size_t m_chunk_size {};
+
+    SilentDynArray<buffer_type> m_buffers {};
+
+    std::size_t m_submitted {};      // Amount of chunks given to the I/O thread so far
+    std::size_t m_written {};        // Amount of chunks written by the I/O thread so far
+    bool m_failed { false };
+    bool m_stopping { false };
+
+    std::mutex m_mutex {};
+    std::condition_variable m_chunk_submitted {};
+    std::condition_variable m_chunk_written {};
+    std::thread m_io_thread {};
+
+    void io_loop()
+    {
+        while (true)
+        {
+            buffer_type* buffer { nullptr };
+
+            {
+                std::unique_lock lock { m_mutex };
+                m_chunk_submitted.wait(lock, [this] { return m_stopping || (m_submitted > m_written); });
+
+                if (m_submitted == m_written)
+                {
+                    break;
+                }
+
+                buffer = &m_buffers[m_written % m_buffers.size()];
+            }
+
+            bool written { write_all(m_fd, buffer->data(), buffer->size()) };
+
+            {
+                std::lock_guard lock { m_mutex };
+
+                if (!written)
+                {
+                    m_failed = true;
+                }
+
+                m_written++;
+            }
+
+            m_chunk_written.notify_all();
+        }
+    }
+
+public:
+    // The writer doesn't own "fd", so it has to be closed by the caller after the ChunkStreamWriter is destroyed
+    ChunkStreamWriter(int fd, std::size_t chunk_size, std::size_t buffer_count = 4)
+    : m_fd { fd },
+      m_chunk_size { chunk_size },
+      m_buffers(buffer_count)
+    {
+        BASIC_ASSERT((chunk_size > 0), "The size of the chunks must be bigger than 0.\n");
+        BASIC_ASSERT((buffer_count > 1), "At least 2 buffers are needed, so one can be filled while the other one is written.\n");
+
+        for (buffer_type& buffer : m_buffers)
+        {
+            buffer.reserve_memory(m_chunk_size);
+        }
+
+        m_io_thread = std::thread { &ChunkStreamWriter::io_loop, this };
+    }
+
+    ChunkStreamWriter(const ChunkStreamWriter& other) = delete;
+    ChunkStreamWriter& operator=(const ChunkStreamWriter& other) = delete;
+
+    // All the submitted chunks are written before the I/O thread stops
+    ~ChunkStreamWriter()
+    {
+        {
+            std::lock_guard lock { m_mutex };
+            m_stopping = true;
+        }
+
+        m_chunk_submitted.notify_one();
+        m_io_thread.join();
+    }
+
+    // It waits for a free buffer and returns it empty. Don't fill it with more than chunk_size() bytes,
+    // or it will reallocate. Calling it again before submit() returns the same buffer
+    buffer_type& acquire()
+    {
+        std::unique_lock lock { m_mutex };
+        m_chunk_written.wait(lock, [this] { return ((m_submitted - m_written) < m_buffers.size()); });
+
+        buffer_type& buffer { m_buffers[m_submitted % m_buffers.size()] };
+        buffer.destroy_all();
+
+        return buffer;
+    }
+
+    // It hands the buffer returned by acquire() to the I/O thread
+    void submit()
+    {
+        {
+            std::lock_guard lock { m_mutex };
+            m_submitted++;
+        }
+
+        m_chunk_submitted.notify_one();
+    }
+
+    // It waits until every submitted chunk is written, and returns false if any of the writes failed
+    bool flush()
+    {
+        std::unique_lock lock { m_mutex };
+        m_chunk_written.wait(lock, [this] { return (m_submitted == m_written); });
+
+        return !m_failed;
+    }
+
+    std::size_t chunk_size() const noexcept { return m_chunk_size; }
+
+    std::size_t buffer_count() const noexcept { return m_buffers.size(); }
+};
+
+} // namespace hdsa end
+
+#endif // defined(__unix__) || defined(__APPLE__)
+
+#endif // CHUNK_STREAM_HPP
@@ -0,0 +1,389 @@
+#ifndef CONCURRENT_QUEUES_HPP
+#define CONCURRENT_QUEUES_HPP
+
+#include "dyn_array.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <bit>
+#include <atomic>
+#include <limits>
+#include <new>
+#include <utility>
+
+/**
+ * Bounded lock-free queues to pass elements (or whole DynArrays) between threads:
+ * SpscQueue is for exactly one producer and one consumer thread. Each side keeps a cached copy of
+ * the index of the other side, so the fast path has no read-modify-write atomic operations and
+ * only touches the shared cache line when the cached copy says the queue looks full or empty.
+ * MpmcQueue is for any amount of producers and consumers. It's Dmitry Vyukov's bounded queue:
+ * every cell has a sequence number that says which "lap" of the ring can write or read it, so
+ * producers and consumers only compete on a single compare-and-swap each.
+ * Both capacities are rounded up to a power of 2, the indices live in their own cache lines to
+ * avoid false sharing, and both offer batched operations that claim several cells at once.
+*/
+
+namespace hdsa
+{
+
+// std::hardware_destructive_interference_size isn't stable across compiler flags, so it's fixed here
+inline constexpr std::size_t cache_line_size { 64 };
+
+template<typename T>
+class SpscQueue final
+{
+private:
+    // Raw memory for the elements, they are only constructed while they are inside the queue
+    struct alignas(T) Slot final
+    {
+        unsigned char bytes[sizeof(T)];
+    };
+
+    Slot* m_slots { nullptr };
+    std::size_t m_capacity {};
+    std::size_t m_mask {};
+
+    // Written by the producer, read by the consumer
+    alignas(cache_line_size) std::atomic<std::size_t> m_tail {};
+    // Only used by the producer
+    alignas(cache_line_size) std::size_t m_cached_head {};
+
+    // Written by the consumer, read by the producer
+    alignas(cache_line_size) std::atomic<std::size_t> m_head {};
+    // Only used by the consumer
+    alignas(cache_line_size) std::size_t m_cached_tail {};
+
+    T* element(std::size_t index) noexcept
+    {
+        return std::launder(reinterpret_cast<T*>(m_slots[index & m_mask].bytes));
+    }
+
+public:
+    explicit SpscQueue(std::size_t capacity)
+    : m_capacity { std::bit_ceil((capacity < 2) ? std::size_t { 2 } : capacity) },
+      m_mask { m_capacity - 1 }
+    {
+        BASIC_ASSERT((capacity <= (std::numeric_limits<std::size_t>::max() / 2) + 1), "The capacity of the queue is too big to be rounded up to a power of 2.\n");
+
+        m_slots = static_cast<Slot*>(::operator new(m_capacity * sizeof(Slot), std::align_val_t { alignof(Slot) }));
+    }
+
+    SpscQueue(const SpscQueue& other) = delete;
+    SpscQueue& operator=(const SpscQueue& other) = delete;
+
+    ~SpscQueue()
+    {
+        std::size_t head { m_head.load(std::memory_order_relaxed) };
+        std::size_t tail { m_tail.load(std::memory_order_relaxed) };
+
+        for (; head != tail; head++)
+        {
+            element(head)->~T();
+        }
+
+        ::operator delete(m_slots, m_capacity * sizeof(Slot), std::align_val_t { alignof(Slot) });
+    }
+
+    std::size_t capacity() const noexcept { return m_capacity; }
+
+    // Only an approximation while the other thread is working
+    std::size_t size_approx() const noexcept
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    // Producer side. It returns false if the queue is full
+    template<typename... Args>
+    bool try_emplace(Args&&... args)
+    {
+        std::size_t tail { m_tail.load(std::memory_order_relaxed) };
+
+        if ((tail - m_cached_head) == m_capacity)
+        {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+
+            if ((tail - m_cached_head) == m_capacity)
+            {
+                return false;
+            }
+        }
+
+        new (m_slots[tail & m_mask].bytes) T(std::forward<Args>(args)...);
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    bool try_push(const T& t) { return try_emplace(t); }
+
+    bool try_push(T&& t) { return try_emplace(std::move(t)); }
+
+    // Producer side. It pushes as many of the "amount" elements as fit, with a single release store,
+    // and returns how many were pushed
+    std::size_t try_push_n(const T* elements, std::size_t amount)
+    {
+        std::size_t tail { m_tail.load(std::memory_order_relaxed) };
+        std::size_t free_spots { m_capacity - (tail - m_cached_head) };
+
+        if (free_spots < amount)
+        {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+            free_spots = m_capacity - (tail - m_cached_head);
+        }
+
+        std::size_t count { (amount < free_spots) ? amount : free_spots };
+
+        for (std::size_t i {}; i < count; i++)
+        {
+            new (m_slots[(tail + i) & m_mask].bytes) T(elements[i]);
+        }
+
+        m_tail.store(tail + count, std::memory_order_release);
+
+        return count;
+    }
+
+    // Consumer side. It returns false if the queue is empty
+    bool try_pop(T& t)
+    {
+        std::size_t head { m_head.load(std::memory_order_relaxed) };
+
+        if (head == m_cached_tail)
+        {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+
+            if (head == m_cached_tail)
+            {
+                return false;
+            }
+        }
+
+        T* e { element(head) };
+        t = std::move(*e);
+        e->~T();
+
+        m_head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // Consumer side. It pops up to "amount" elements into "out" with a single release store, and returns
+    // how many were popped
+    std::size_t try_pop_n(T* out, std::size_t amount)
+    {
+        std::size_t head { m_head.load(std::memory_order_relaxed) };
+        std::size_t available { m_cached_tail - head };
+
+        if (available < amount)
+        {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+            available = m_cached_tail - head;
+        }
+
+        std::size_t count { (amount < available) ? amount : available };
+
+        for (std::size_t i {}; i < count; i++)
+        {
+            T* e { element(head + i) };
+            out[i] = std::move(*e);
+            e->~T();
+        }
+
+        m_head.store(head + count, std::memory_order_release);
+
+        return count;
+    }
+};
+
+template<typename T>
+class MpmcQueue final
+{
+private:
+    struct Cell final
+    {
+        std::atomic<std::size_t> sequence {};
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+
+    Cell* m_cells { nullptr };
+    std::size_t m_capacity {};
+    std::size_t m_mask {};
+
+    alignas(cache_line_size) std::atomic<std::size_t> m_enqueue_position {};
+    alignas(cache_line_size) std::atomic<std::size_t> m_dequeue_position {};
+
+    T* element(Cell& cell) noexcept
+    {
+        return std::launder(reinterpret_cast<T*>(cell.bytes));
+    }
+
+    // It claims up to "amount" consecutive cells whose sequence is "position + offset" for each one, which
+    // means they are ready for the side that owns "counter". It returns the first position and the amount claimed
+    std::pair<std::size_t, std::size_t> claim(std::atomic<std::size_t>& counter, std::size_t offset, std::size_t amount)
+    {
+        std::size_t position { counter.load(std::memory_order_relaxed) };
+
+        // Otherwise no cell is ever checked and the loop below never ends
+        if (amount == 0)
+        {
+            return { position, 0 };
+        }
+
+        while (true)
+        {
+            std::size_t count {};
+            std::intptr_t difference {};
+
+            while (count < amount)
+            {
+                std::size_t sequence { m_cells[(position + count) & m_mask].sequence.load(std::memory_order_acquire) };
+                difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + count + offset);
+
+                if (difference != 0)
+                {
+                    break;
+                }
+
+                count++;
+            }
+
+            if (count == 0)
+            {
+                // The cell is from a previous lap, so the queue is full (or empty for consumers)
+                if (difference < 0)
+                {
+                    return { position, 0 };
+                }
+
+                // Another thread claimed it first
+                position = counter.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            if (counter.compare_exchange_weak(position, position + count, std::memory_order_relaxed))
+            {
+                return { position, count };
+            }
+        }
+    }
+
+public:
+    explicit MpmcQueue(std::size_t capacity)
+    : m_capacity { std::bit_ceil((capacity < 2) ? std::size_t { 2 } : capacity) },
+      m_mask { m_capacity - 1 }
+    {
+        BASIC_ASSERT((capacity <= (std::numeric_limits<std::size_t>::max() / 2) + 1), "The capacity of the queue is too big to be rounded up to a power of 2.\n");
+
+        m_cells = static_cast<Cell*>(::operator new(m_capacity * sizeof(Cell), std::align_val_t { alignof(Cell) }));
+
+        for (std::size_t i {}; i < m_capacity; i++)
+        {
+            new (m_cells + i) Cell {};
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue& other) = delete;
+    MpmcQueue& operator=(const MpmcQueue& other) = delete;
+
+    ~MpmcQueue()
+    {
+        std::size_t head { m_dequeue_position.load(std::memory_order_relaxed) };
+        std::size_t tail { m_enqueue_position.load(std::memory_order_relaxed) };
+
+        for (; head != tail; head++)
+        {
+            element(m_cells[head & m_mask])->~T();
+        }
+
+        for (std::size_t i {}; i < m_capacity; i++)
+        {
+            m_cells[i].~Cell();
+        }
+
+        ::operator delete(m_cells, m_capacity * sizeof(Cell), std::align_val_t { alignof(Cell) });
+    }
+
+    std::size_t capacity() const noexcept { return m_capacity; }
+
+    // Only an approximation while other threads are working
+    std::size_t size_approx() const noexcept
+    {
+        return m_enqueue_position.load(std::memory_order_acquire) - m_dequeue_position.load(std::memory_order_acquire);
+    }
+
+    template<typename... Args>
+    bool try_emplace(Args&&... args)
+    {
+        auto [position, count] { claim(m_enqueue_position, 0, 1) };
+
+        if (count == 0)
+        {
+            return false;
+        }
+
+        Cell& cell { m_cells[position & m_mask] };
+        new (cell.bytes) T(std::forward<Args>(args)...);
+        cell.sequence.store(position + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    bool try_push(const T& t) { return try_emplace(t); }
+
+    bool try_push(T&& t) { return try_emplace(std::move(t)); }
+
+    // It claims as many consecutive cells as possible with a single compare-and-swap, up to "amount", and
+    // returns how many elements were pushed
+    std::size_t try_push_n(const T* elements, std::size_t amount)
+    {
+        auto [position, count] { claim(m_enqueue_position, 0, amount) };
+
+        for (std::size_t i {}; i < count; i++)
+        {
+            Cell& cell { m_cells[(position + i) & m_mask] };
+            new (cell.bytes) T(elements[i]);
+            cell.sequence.store(position + i + 1, std::memory_order_release);
+        }
+
+        return count;
+    }
+
+    bool try_pop(T& t)
+    {
+        auto [position, count] { claim(m_dequeue_position, 1, 1) };
+
+        if (count == 0)
+        {
+            return false;
+        }
+
+        Cell& cell { m_cells[position & m_mask] };
+        T* e { element(cell) };
+        t = std::move(*e);
+        e->~T();
+        cell.sequence.store(position + m_mask + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    std::size_t try_pop_n(T* out, std::size_t amount)
+    {
+        auto [position, count] { claim(m_dequeue_position, 1, amount) };
+
+        for (std::size_t i {}; i < count; i++)
+        {
+            Cell& cell { m_cells[(position + i) & m_mask] };
+            T* e { element(cell) };
+            out[i] = std::move(*e);
+            e->~T();
+            cell.sequence.store(position + i + m_mask + 1, std::memory_order_release);
+        }
+
+        return count;
+    }
+};
+
+} // namespace hdsa end
+
+#endif // CONCURRENT_QUEUES_HPP
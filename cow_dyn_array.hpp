@@ -0,0 +1,309 @@
+#ifndef COW_DYN_ARRAY_HPP
+#define COW_DYN_ARRAY_HPP
+
+#include "dyn_array.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <initializer_list>
+
+/**
+ * Personal implementation of a copy-on-write Dynamic Array. Copying a CowDynArray doesn't copy the elements,
+ * both copies share the same DynArray through an atomic reference count, so taking snapshots of big arrays
+ * is O(1). The elements are only copied the first time a shared CowDynArray is modified ("detaching" it),
+ * and only the one being modified gets the new copy.
+ * To avoid detaching by accident, element access and iteration are read-only. Single elements can be changed
+ * with set(), and make_unique() detaches once and gives the underlying DynArray for everything else.
+ * Like std::shared_ptr, different CowDynArray objects sharing the same elements can be used from different
+ * threads, but a single CowDynArray object can't be modified from one thread while other threads use it.
+*/
+
+namespace hdsa
+{
+
+template<typename T>
+class CowDynArray final
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    using const_iterator = typename DynArray<T>::const_iterator;
+
+private:
+    struct Block final
+    {
+        std::atomic<std::size_t> ref_count { 1 };
+        DynArray<T> elements {};
+
+        Block() = default;
+
+        explicit Block(const DynArray<T>& other)
+        : elements { other } {}
+
+        explicit Block(DynArray<T>&& other)
+        : elements { std::move(other) } {}
+    };
+
+    // nullptr for an empty CowDynArray that has never had elements, so default construction doesn't allocate
+    Block* m_block { nullptr };
+
+    // Shared by every CowDynArray without a block, so the read-only functions always have a DynArray to look at
+    static const DynArray<T>& empty_array()
+    {
+        static const DynArray<T> empty {};
+
+        return empty;
+    }
+
+    // The last owner deletes the block. acq_rel so every use of the elements by the other owners happens
+    // before the deletion
+    void release() noexcept
+    {
+        if ((m_block != nullptr) && (m_block->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1))
+        {
+            delete m_block;
+        }
+
+        m_block = nullptr;
+    }
+
+    // After it, this CowDynArray is the only owner of its block, so the elements can be modified
+    DynArray<T>& detach()
+    {
+        if (m_block == nullptr)
+        {
+            m_block = new Block {};
+        }
+        else if (is_shared())
+        {
+            Block* copy { new Block { m_block->elements } };
+
+            release();
+            m_block = copy;
+        }
+
+        return m_block->elements;
+    }
+
+public:
+    CowDynArray() = default;
+
+    CowDynArray(std::initializer_list<T> other)
+    : m_block { new Block { DynArray<T> { other } } } {}
+
+    // It takes ownership of the elements of "other" without copying them
+    explicit CowDynArray(DynArray<T>&& other)
+    : m_block { new Block { std::move(other) } } {}
+
+    explicit CowDynArray(const DynArray<T>& other)
+    : m_block { new Block { other } } {}
+
+    // O(1), the elements are shared
+    CowDynArray(const CowDynArray& other) noexcept
+    : m_block { other.m_block }
+    {
+        if (m_block != nullptr)
+        {
+            m_block->ref_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    CowDynArray(CowDynArray&& other) noexcept
+    : m_block { std::exchange(other.m_block, nullptr) } {}
+
+    CowDynArray& operator=(const CowDynArray& other) noexcept
+    {
+        if ((this == &other) || (m_block == other.m_block))
+        {
+            return *this;
+        }
+
+        release();
+        m_block = other.m_block;
+
+        if (m_block != nullptr)
+        {
+            m_block->ref_count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        return *this;
+    }
+
+    CowDynArray& operator=(CowDynArray&& other) noexcept
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        release();
+        m_block = std::exchange(other.m_block, nullptr);
+
+        return *this;
+    }
+
+    ~CowDynArray()
+    {
+        release();
+    }
+
+    // How many CowDynArrays share the elements, 0 if there are none. acquire, so the uses of the elements
+    // by owners that are already gone happen before any modification done after checking it
+    std::size_t use_count() const noexcept
+    {
+        return (m_block == nullptr) ? 0 : m_block->ref_count.load(std::memory_order_acquire);
+    }
+
+    bool is_shared() const noexcept
+    {
+        return (use_count() > 1);
+    }
+
+    // The escape hatch for everything the read-only interface doesn't cover (mutable iteration, algorithms,
+    // etc.). It detaches if needed and returns the DynArray, which stays unique until this CowDynArray is copied
+    DynArray<T>& make_unique()
+    {
+        return detach();
+    }
+
+    // The read-only view of the elements, it never copies them
+    const DynArray<T>& array() const noexcept
+    {
+        return (m_block == nullptr) ? empty_array() : m_block->elements;
+    }
+
+    std::size_t size() const noexcept { return (m_block == nullptr) ? 0 : m_block->elements.size(); }
+
+    bool is_empty() const noexcept { return (size() == 0); }
+
+    std::size_t capacity() const noexcept { return (m_block == nullptr) ? 0 : m_block->elements.capacity(); }
+
+    const T* data() const noexcept { return (m_block == nullptr) ? nullptr : m_block->elements.data(); }
+
+    const T& operator[](std::size_t position) const
+    {
+        return array()[position];
+    }
+
+    const T& at_checked(std::size_t position) const
+    {
+        return array().at_checked(position);
+    }
+
+    const T& first() const
+    {
+        return array().first();
+    }
+
+    const T& last() const
+    {
+        return array().last();
+    }
+
+    // Element modification, all of them detach first if the elements are shared
+    void set(std::size_t position, const T& t)
+    {
+        detach().at_checked(position) = t;
+    }
+
+    void set(std::size_t position, T&& t)
+    {
+        detach().at_checked(position) = std::move(t);
+    }
+
+    void push_back(const T& t)
+    {
+        detach().push_back(t);
+    }
+
+    void push_back(T&& t)
+    {
+        detach().push_back(std::move(t));
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        return detach().emplace_back(std::forward<Args>(args)...);
+    }
+
+    void pop_back()
+    {
+        if (is_empty())
+        {
+            std::cout << "The CowDynArray is already empty, no elements will be popped out.\n";
+            return;
+        }
+
+        detach().pop_back();
+    }
+
+    // The positions are indices because the iterators are read-only
+    void insert(std::size_t position, const T& t)
+    {
+        DynArray<T>& elements { detach() };
+
+        elements.insert(elements.cbegin() + static_cast<std::ptrdiff_t>(position), t);
+    }
+
+    void erase(std::size_t position)
+    {
+        DynArray<T>& elements { detach() };
+
+        elements.erase(elements.cbegin() + static_cast<std::ptrdiff_t>(position));
+    }
+
+    template<typename Predicate>
+    std::size_t erase_if(Predicate predicate)
+    {
+        return detach().erase_if(predicate);
+    }
+
+    void resize(std::size_t element_amount)
+    {
+        detach().resize(element_amount);
+    }
+
+    void resize(std::size_t element_amount, const T& value)
+    {
+        detach().resize(element_amount, value);
+    }
+
+    void reserve_memory(std::size_t element_amount)
+    {
+        if (element_amount > capacity())
+        {
+            detach().reserve_memory(element_amount);
+        }
+    }
+
+    // Shared elements aren't copied just to be destroyed, this CowDynArray simply stops sharing them
+    void clear()
+    {
+        if (is_shared())
+        {
+            release();
+            return;
+        }
+
+        if (m_block != nullptr)
+        {
+            m_block->elements.destroy_all();
+        }
+    }
+
+    // Read-only iteration, use make_unique() to modify the elements while iterating
+    const_iterator begin() const noexcept { return array().begin(); }
+
+    const_iterator end() const noexcept { return array().end(); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+};
+
+} // namespace hdsa end
+
+#endif // COW_DYN_ARRAY_HPP
@@ -0,0 +1,398 @@
+#ifndef DARY_HEAP_HPP
+#define DARY_HEAP_HPP
+
+#include "dyn_array.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <iterator>
+#include <functional>
+#include <iostream>
+#include <utility>
+#include <initializer_list>
+
+/**
+ * Personal implementation of a priority queue as an implicit d-ary heap stored in a DynArray.
+ * With Arity = 4 the children of a node usually share a cache line and the heap is half as deep
+ * as a binary one, so pops touch less memory than with std::priority_queue. Like it, the element
+ * on top is the biggest one according to Compare (std::less), so std::greater makes a min-heap.
+ * Optionally, an IdOf function object can map every element to a unique std::size_t id, and then
+ * the heap keeps an index map from ids to positions so the priority of an element can be changed
+ * in O(log n) with decrease_key() or update_key().
+ * The index map is a DynArray indexed by id, so it takes one std::size_t per id up to the biggest one.
+ * The ids have to be small and dense (e.g. 0 to n - 1, like the vertices of a graph). Hashes or other
+ * sparse ids have to be mapped to dense ones first, e.g. with a FlatHashMap or the slots of a SlotMap.
+*/
+
+namespace hdsa
+{
+
+template<typename T, std::size_t Arity = 4, typename Compare = std::less<T>, typename IdOf = void>
+class DaryHeap final
+{
+    static_assert((Arity >= 2), "The arity of the heap must be at least 2.");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using value_compare = Compare;
+
+    using const_reference = const value_type&;
+
+    static constexpr std::size_t arity { Arity };
+
+    // Position of the ids that aren't in the heap
+    static constexpr std::size_t npos { static_cast<std::size_t>(-1) };
+
+    static constexpr bool has_index_map { !std::is_void_v<IdOf> };
+
+private:
+    // An empty type takes the place of the IdOf object and the index map when they aren't used
+    struct NoIndexMap final {};
+
+    using IdOfType = std::conditional_t<has_index_map, IdOf, NoIndexMap>;
+    using PositionsType = std::conditional_t<has_index_map, SilentDynArray<std::size_t>, NoIndexMap>;
+
+    SilentDynArray<T> m_elements {};
+    [[no_unique_address]] Compare m_compare {};
+    [[no_unique_address]] IdOfType m_id_of {};
+    [[no_unique_address]] PositionsType m_positions {};
+
+    static std::size_t parent(std::size_t index) noexcept { return (index - 1) / Arity; }
+
+    static std::size_t first_child(std::size_t index) noexcept { return (index * Arity) + 1; }
+
+    // Every element that's moved inside the heap has to update its spot in the index map, which grows
+    // up to the biggest id seen so far
+    void record_position(std::size_t index)
+    {
+        if constexpr (has_index_map)
+        {
+            std::size_t id { static_cast<std::size_t>(m_id_of(std::as_const(m_elements[index]))) };
+
+            if (id >= m_positions.size())
+            {
+                m_positions.resize(id + 1, npos);
+            }
+
+            m_positions[id] = index;
+        }
+    }
+
+    void place(std::size_t index, T&& t)
+    {
+        m_elements[index] = std::move(t);
+        record_position(index);
+    }
+
+    // The element at "index" is taken out, leaving a "hole" that goes up while the parent has less priority,
+    // so every step is a single move instead of a swap
+    void sift_up(std::size_t index)
+    {
+        T t { std::move(m_elements[index]) };
+
+        while (index > 0)
+        {
+            std::size_t p { parent(index) };
+
+            if (!m_compare(m_elements[p], t))
+            {
+                break;
+            }
+
+            place(index, std::move(m_elements[p]));
+            index = p;
+        }
+
+        place(index, std::move(t));
+    }
+
+    void sift_down(std::size_t index)
+    {
+        std::size_t size { m_elements.size() };
+        T t { std::move(m_elements[index]) };
+
+        while (true)
+        {
+            std::size_t first { first_child(index) };
+
+            if (first >= size)
+            {
+                break;
+            }
+
+            std::size_t last { ((first + Arity) < size) ? (first + Arity) : size };
+            std::size_t best { first };
+
+            for (std::size_t child { first + 1 }; child < last; child++)
+            {
+                if (m_compare(m_elements[best], m_elements[child]))
+                {
+                    best = child;
+                }
+            }
+
+            if (!m_compare(t, m_elements[best]))
+            {
+                break;
+            }
+
+            place(index, std::move(m_elements[best]));
+            index = best;
+        }
+
+        place(index, std::move(t));
+    }
+
+    // Floyd's algorithm, every parent is sifted down starting from the last one, so it takes O(n)
+    void heapify()
+    {
+        std::size_t size { m_elements.size() };
+
+        if (size < 2)
+        {
+            if (size == 1)
+            {
+                record_position(0);
+            }
+
+            return;
+        }
+
+        for (std::size_t i { parent(size - 1) + 1 }; i > 0; i--)
+        {
+            sift_down(i - 1);
+        }
+
+        // The leaves were never moved, so they still need their spot in the index map
+        if constexpr (has_index_map)
+        {
+            for (std::size_t i { parent(size - 1) + 1 }; i < size; i++)
+            {
+                record_position(i);
+            }
+        }
+    }
+
+    // It takes the top element out of the index map
+    void forget_top()
+    {
+        if constexpr (has_index_map)
+        {
+            m_positions[static_cast<std::size_t>(m_id_of(std::as_const(m_elements[0])))] = npos;
+        }
+    }
+
+    // The last element takes the place of the top one and goes down. The top element must not be in
+    // the index map anymore, and it can be moved-from
+    void remove_top()
+    {
+        std::size_t last { m_elements.size() - 1 };
+
+        if (last > 0)
+        {
+            m_elements[0] = std::move(m_elements[last]);
+        }
+
+        m_elements.pop_back();
+
+        if (!is_empty())
+        {
+            sift_down(0);
+        }
+    }
+
+    std::size_t position_of(std::size_t id) const
+    {
+        BASIC_ASSERT(((id < m_positions.size()) && (m_positions[id] != npos)), "There's no element with that id in the heap.\n");
+
+        return m_positions[id];
+    }
+
+public:
+    DaryHeap() = default;
+
+    explicit DaryHeap(const Compare& compare)
+    : m_compare { compare } {}
+
+    // It builds the heap from a range in O(n)
+    template<typename InputIt>
+    DaryHeap(InputIt first, InputIt last, const Compare& compare = Compare {})
+    : m_compare { compare }
+    {
+        push_range(first, last);
+    }
+
+    DaryHeap(std::initializer_list<T> other)
+    {
+        push_range(other.begin(), other.end());
+    }
+
+    std::size_t size() const noexcept { return m_elements.size(); }
+
+    bool is_empty() const noexcept { return m_elements.is_empty(); }
+
+    std::size_t capacity() const noexcept { return m_elements.capacity(); }
+
+    void reserve_memory(std::size_t element_amount)
+    {
+        if (element_amount > m_elements.capacity())
+        {
+            m_elements.reserve_memory(element_amount);
+        }
+    }
+
+    const T& top() const
+    {
+        BASIC_ASSERT(!is_empty(), "The heap is empty, there's no top element.\n");
+
+        return m_elements[0];
+    }
+
+    void push(const T& t)
+    {
+        m_elements.push_back(t);
+        sift_up(m_elements.size() - 1);
+    }
+
+    void push(T&& t)
+    {
+        m_elements.push_back(std::move(t));
+        sift_up(m_elements.size() - 1);
+    }
+
+    template<typename... Args>
+    void emplace(Args&&... args)
+    {
+        m_elements.emplace_back(std::forward<Args>(args)...);
+        sift_up(m_elements.size() - 1);
+    }
+
+    // Bulk insertion. When the new elements are as many as the ones already in the heap, rebuilding the
+    // whole heap in O(n) is cheaper than sifting every new element up
+    template<typename InputIt>
+    void push_range(InputIt first, InputIt last)
+    {
+        std::size_t old_size { m_elements.size() };
+
+        if constexpr (std::forward_iterator<InputIt>)
+        {
+            reserve_memory(old_size + static_cast<std::size_t>(std::distance(first, last)));
+        }
+
+        for (; first != last; ++first)
+        {
+            m_elements.push_back(*first);
+        }
+
+        std::size_t added { m_elements.size() - old_size };
+
+        if (added >= old_size)
+        {
+            heapify();
+            return;
+        }
+
+        for (std::size_t i { old_size }; i < m_elements.size(); i++)
+        {
+            sift_up(i);
+        }
+    }
+
+    template<typename Range>
+    void push_range(Range&& range)
+    {
+        push_range(std::begin(range), std::end(range));
+    }
+
+    void pop()
+    {
+        if (is_empty())
+        {
+            std::cout << "The heap is already empty, no elements will be popped out.\n";
+            return;
+        }
+
+        forget_top();
+        remove_top();
+    }
+
+    // It removes the top element and returns it
+    T extract_top()
+    {
+        BASIC_ASSERT(!is_empty(), "The heap is empty, there's no top element.\n");
+
+        // The id has to be read before the element is moved out
+        forget_top();
+
+        T t { std::move(m_elements[0]) };
+        remove_top();
+
+        return t;
+    }
+
+    void clear()
+    {
+        if constexpr (has_index_map)
+        {
+            for (std::size_t i {}; i < m_positions.size(); i++)
+            {
+                m_positions[i] = npos;
+            }
+        }
+
+        m_elements.destroy_all();
+    }
+
+    // The index map is only available when IdOf isn't void
+    bool contains(std::size_t id) const
+    requires has_index_map
+    {
+        return ((id < m_positions.size()) && (m_positions[id] != npos));
+    }
+
+    // It gives the element with "id" a higher or equal priority, and moves it up
+    void decrease_key(std::size_t id, const T& t)
+    requires has_index_map
+    {
+        std::size_t index { position_of(id) };
+
+        BASIC_ASSERT(!m_compare(t, m_elements[index]), "decrease_key() can't give an element a lower priority, use update_key() instead.\n");
+
+        m_elements[index] = t;
+        sift_up(index);
+    }
+
+    // It changes the element with "id", moving it up or down as needed
+    void update_key(std::size_t id, const T& t)
+    requires has_index_map
+    {
+        std::size_t index { position_of(id) };
+        bool goes_up { m_compare(m_elements[index], t) };
+
+        m_elements[index] = t;
+
+        if (goes_up)
+        {
+            sift_up(index);
+        }
+        else
+        {
+            sift_down(index);
+        }
+    }
+
+    // Read-only access to the underlying storage, in heap order
+    const T* data() const noexcept { return m_elements.data(); }
+
+    typename SilentDynArray<T>::const_iterator begin() const noexcept { return m_elements.begin(); }
+
+    typename SilentDynArray<T>::const_iterator end() const noexcept { return m_elements.end(); }
+};
+
+template<typename T, typename Compare = std::less<T>, typename IdOf = void>
+using BinaryHeap = DaryHeap<T, 2, Compare, IdOf>;
+
+} // namespace hdsa end
+
+#endif // DARY_HEAP_HPP
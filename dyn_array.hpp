@@ -2,6 +2,9 @@
 #define DYN_ARRAY_HPP
 
 #include <cstddef>
+#include <cstring>
+#include <compare>
+#include <algorithm>
 #include <limits>
 #include <type_traits>
 #include <iterator>
@@ -15,6 +18,9 @@
 /**
  * Personal implementation of a Dynamic Array. It uses ::operator new for memory allocation
  * without calling constructors but in the future it will be able to use custom allocators
+ * Every member function is constexpr, so a DynArray can also be used during constant evaluation
+ * (e.g. to build lookup tables at compile time and copy them into a std::array). There it allocates
+ * with std::allocator, doesn't print anything and doesn't use memmove, since none of those are allowed.
 */
 
 /**
@@ -29,7 +35,7 @@
  * 8) Look what other std::vector features could be good to have here.
  * 9) Choose which asserts should be changed for exceptions.
  * 10) Investigate about how to construct with Initializer Lists and how to combine it with In-place Construction. DONE!
- * 11) Investigate (later on, not for now) about C++ 20 ranges and see how to implement them here.
+ * 11) Investigate (later on, not for now) about C++ 20 ranges and see how to implement them here. DONE!
  * 12) Investigate about array slicing and see if it can be implemented here.
 */
 
@@ -48,9 +54,16 @@
 //     std::abort();                                           \
 // }                                                           \
 
+// During constant evaluation there's no std::cerr nor std::abort, so a failed assertion calls a function
+// that isn't constexpr instead, which turns it into a compilation error pointing to the BASIC_ASSERT line
 #define BASIC_ASSERT(condition, message)                    \
-if (!condition)                                             \
+if (!condition) [[unlikely]]                                \
 {                                                           \
+    if (std::is_constant_evaluated())                       \
+    {                                                       \
+        hdsa::basic_assert_failed_during_constant_evaluation(message); \
+    }                                                       \
+                                                            \
     auto loc { std::source_location::current() };           \
     std::cerr                                               \
         << "\n\nAssertion failed: " << message << '\n'      \
@@ -62,10 +75,130 @@ if (!condition)                                             \
     std::abort();                                           \
 }                                                           \
 
+// The same as BASIC_ASSERT, but only when the check policy of the container keeps that kind of check
+// (see hdsa::checked below). They need a "check_policy" type where they're used, and when the policy
+// drops the check the condition isn't even evaluated
+#define BOUNDS_ASSERT(condition, message)                   \
+if constexpr (check_policy::checks_bounds)                  \
+{                                                           \
+    BASIC_ASSERT(condition, message)                        \
+}                                                           \
+
+#define INVARIANT_ASSERT(condition, message)                \
+if constexpr (check_policy::checks_invariants)              \
+{                                                           \
+    BASIC_ASSERT(condition, message)                        \
+}                                                           \
+
+// The check policy used for every element type that doesn't choose its own. It can be changed for a whole
+// build, e.g. with -DHDSA_CHECK_POLICY=hdsa::unchecked
+#ifndef HDSA_CHECK_POLICY
+#define HDSA_CHECK_POLICY hdsa::default_checks
+#endif
+
+// Same idea for the shrink policy, e.g. -DHDSA_SHRINK_POLICY=hdsa::shrink_with_hysteresis<>
+#ifndef HDSA_SHRINK_POLICY
+#define HDSA_SHRINK_POLICY hdsa::never_shrink
+#endif
+
 namespace hdsa
 {
 
+// Deliberately not constexpr, see BASIC_ASSERT
+inline void basic_assert_failed_during_constant_evaluation(const char*) noexcept {}
+
+// Check policies, from the safest to the fastest:
+// - checked: every check, including the internal invariants (e.g. size <= capacity) and the bounds of operator[],
+//   and the DynArray prints what it's doing ("Growing the size.", etc.). Meant for debug builds and canaries
+// - default_checks: what DynArray always did, so it's the default. The same as checked, except that
+//   operator[] is a single load like std::vector's
+// - hardened: only the cheap bounds checks of operator[], at_checked(), first(), last() and the iterators
+//   given to insert() and erase(), and no messages
+// - unchecked: no checks and no messages, so operator[] is a single load and push_back() has no calls
+//   into iostreams, only the branch to grow when the DynArray is full
+struct checked final
+{
+    static constexpr bool checks_bounds { true };
+    static constexpr bool checks_subscript { true };
+    static constexpr bool checks_invariants { true };
+    static constexpr bool prints_messages { true };
+};
+
+struct default_checks final
+{
+    static constexpr bool checks_bounds { true };
+    static constexpr bool checks_subscript { false };
+    static constexpr bool checks_invariants { true };
+    static constexpr bool prints_messages { true };
+};
+
+struct hardened final
+{
+    static constexpr bool checks_bounds { true };
+    static constexpr bool checks_subscript { true };
+    static constexpr bool checks_invariants { false };
+    static constexpr bool prints_messages { false };
+};
+
+struct unchecked final
+{
+    static constexpr bool checks_bounds { false };
+    static constexpr bool checks_subscript { false };
+    static constexpr bool checks_invariants { false };
+    static constexpr bool prints_messages { false };
+};
+
+// The same checks as "Policy" but never any messages, see SilentDynArray
+template<typename Policy>
+struct silent final
+{
+    static constexpr bool checks_bounds { Policy::checks_bounds };
+    static constexpr bool checks_subscript { Policy::checks_subscript };
+    static constexpr bool checks_invariants { Policy::checks_invariants };
+    static constexpr bool prints_messages { false };
+};
+
+// It can be specialized to choose the policy of a single element type, e.g.
+// template<> struct hdsa::check_policy_for<Particle> { using type = hdsa::unchecked; };
+// A single DynArray can also choose its own, e.g. hdsa::DynArray<Particle, hdsa::hardened>
+template<typename T>
+struct check_policy_for
+{
+    using type = HDSA_CHECK_POLICY;
+};
+
+// Shrink policies, for when elements are removed (pop_back(), erase(), unordered_erase(), erase_if() and
+// resize() to a smaller size). Growing always doubles the capacity when the DynArray is full.
+// The default one keeps the capacity until shrink_to_size() is called explicitly
+struct never_shrink final
+{
+    static constexpr bool shrinks { false };
+};
+
+// When the size drops below capacity / ShrinkBelow, the capacity goes down to size * ShrinkTo (but never below
+// MinCapacity). ShrinkTo has to be smaller than ShrinkBelow: right after shrinking, the DynArray is far from
+// both being full and being sparse again, so alternating pushes and pops can't make it reallocate every time.
+// With the default values it shrinks below 25% of the capacity down to 50%, and then it takes doubling
+// the size to grow again or halving it to shrink again
+template<std::size_t ShrinkBelow = 4, std::size_t ShrinkTo = 2, std::size_t MinCapacity = 16>
+struct shrink_with_hysteresis final
+{
+    static_assert((ShrinkTo >= 1) && (ShrinkTo < ShrinkBelow), "ShrinkTo must be at least 1 and smaller than ShrinkBelow, otherwise there's no hysteresis.");
+
+    static constexpr bool shrinks { true };
+    static constexpr std::size_t shrink_below { ShrinkBelow };
+    static constexpr std::size_t shrink_to { ShrinkTo };
+    static constexpr std::size_t min_capacity { MinCapacity };
+};
+
+// It can be specialized for a single element type, like check_policy_for
 template<typename T>
+struct shrink_policy_for
+{
+    using type = HDSA_SHRINK_POLICY;
+};
+
+template<typename T, typename CheckPolicy = typename check_policy_for<T>::type>
 class DynArray final
 {
 public:
@@ -85,6 +218,9 @@ public:
     using reference = value_type&;
     using const_reference = const value_type&;
 
+    using check_policy = CheckPolicy;
+    using shrink_policy = typename shrink_policy_for<T>::type;
+
 private:
     T* m_first_ptr { nullptr };
     std::size_t m_size {};
@@ -109,108 +245,117 @@ private:
         pointer m_ptr { nullptr };
 
     public:
-        Iterator(pointer ptr)
+        // Needed by std::sentinel_for, so the iterators can be used by std::ranges algorithms
+        Iterator() = default;
+
+        constexpr Iterator(pointer ptr)
         : m_ptr { ptr } {}
 
-        pointer operator->()
+        // std::to_address() uses it to get the raw pointer of the iterator
+        constexpr pointer operator->() const
         {
             return m_ptr;
         }
 
-        reference operator*() const
+        constexpr reference operator*() const
         {
             return *m_ptr;
         }
 
-        pointer data()
+        constexpr pointer data() const
         {
             return m_ptr;
         }
 
-        reference operator[](std::size_t position) const
+        constexpr reference operator[](const difference_type position) const
         {
             return m_ptr[position];
         }
 
-        Iterator& operator++()
+        constexpr Iterator& operator++()
         {
             ++m_ptr;
             return *this;
         }
 
-        Iterator operator++(int)
+        constexpr Iterator operator++(int)
         {
             Iterator iterator { *this };
             ++(*this);
             return iterator;
         }
 
-        Iterator& operator--()
+        constexpr Iterator& operator--()
         {
             --m_ptr;
             return *this;
         }
 
-        Iterator operator--(int)
+        constexpr Iterator operator--(int)
         {
             Iterator iterator { *this };
             --(*this);
             return iterator;
         }
 
-        Iterator& operator+=(int x)
+        constexpr Iterator& operator+=(const difference_type x)
         {
             m_ptr += x;
             return *this;
         }
 
-        Iterator& operator-=(int x)
+        constexpr Iterator& operator-=(const difference_type x)
         {
             m_ptr -= x;
             return *this;
         }
 
-        Iterator operator+(const difference_type x) const
+        constexpr Iterator operator+(const difference_type x) const
         {
             return Iterator { m_ptr + x };
         }
 
-        Iterator operator-(const difference_type x) const
+        constexpr Iterator operator-(const difference_type x) const
         {
             return Iterator { m_ptr - x };
         }
 
-        difference_type operator-(const Iterator& other) const
+        friend constexpr Iterator operator+(const difference_type x, const Iterator& it)
+        {
+            return it + x;
+        }
+
+        constexpr difference_type operator-(const Iterator& other) const
         {
             return m_ptr - other.m_ptr;
         }
 
-        friend bool operator==(const Iterator& a, const Iterator& other)
+        friend constexpr bool operator==(const Iterator& a, const Iterator& other)
         {
             return (a.m_ptr == other.m_ptr);
         }
 
-        friend bool operator!=(const Iterator& a, const Iterator& other)
+        friend constexpr bool operator!=(const Iterator& a, const Iterator& other)
         {
             return (a.m_ptr != other.m_ptr);
         }
 
-        friend bool operator<(const Iterator& a, const Iterator& other)
+        friend constexpr bool operator<(const Iterator& a, const Iterator& other)
         {
             return (a.m_ptr < other.m_ptr);
         }
 
-        friend bool operator>(const Iterator& a, const Iterator& other)
+        friend constexpr bool operator>(const Iterator& a, const Iterator& other)
         {
             return (a.m_ptr > other.m_ptr);
         }
 
-        friend bool operator<=(const Iterator& a, const Iterator& other)
+        friend constexpr bool operator<=(const Iterator& a, const Iterator& other)
         {
             return (a.m_ptr <= other.m_ptr);
         }
 
-        friend bool operator>=(const Iterator& a, const Iterator& other)
+        friend constexpr bool operator>=(const Iterator& a, const Iterator& other)
         {
             return (a.m_ptr >= other.m_ptr);
         }
@@ -227,7 +372,7 @@ private:
         using difference_type = std::ptrdiff_t;
 
         using value_type = DynArray::value_type;
-        using element_type = value_type;
+        using element_type = const value_type;
 
         using pointer = const value_type*;
 
@@ -240,108 +385,121 @@ private:
         pointer m_ptr { nullptr };
 
     public:
-        ConstIterator(pointer ptr)
+        // Needed by std::sentinel_for, so the iterators can be used by std::ranges algorithms
+        ConstIterator() = default;
+
+        constexpr ConstIterator(pointer ptr)
         : m_ptr { ptr } {}
 
-        pointer operator->()
+        // Every Iterator can be used where a ConstIterator is expected, just like with pointers
+        constexpr ConstIterator(const Iterator& it)
+        : m_ptr { it.data() } {}
+
+        // std::to_address() uses it to get the raw pointer of the iterator
+        constexpr pointer operator->() const
         {
             return m_ptr;
         }
 
-        reference operator*() const
+        constexpr reference operator*() const
         {
             return *m_ptr;
         }
 
-        pointer data()
+        constexpr pointer data() const
         {
             return m_ptr;
         }
 
-        reference operator[](std::size_t position) const
+        constexpr reference operator[](const difference_type position) const
         {
             return m_ptr[position];
         }
 
-        ConstIterator& operator++()
+        constexpr ConstIterator& operator++()
         {
             ++m_ptr;
             return *this;
         }
 
-        ConstIterator operator++(int)
+        constexpr ConstIterator operator++(int)
         {
             ConstIterator iterator { *this };
             ++(*this);
             return iterator;
         }
 
-        ConstIterator& operator--()
+        constexpr ConstIterator& operator--()
         {
             --m_ptr;
             return *this;
         }
 
-        ConstIterator operator--(int)
+        constexpr ConstIterator operator--(int)
         {
             ConstIterator iterator { *this };
             --(*this);
             return iterator;
         }
 
-        ConstIterator& operator+=(int x)
+        constexpr ConstIterator& operator+=(const difference_type x)
         {
             m_ptr += x;
             return *this;
         }
 
-        ConstIterator& operator-=(int x)
+        constexpr ConstIterator& operator-=(const difference_type x)
         {
             m_ptr -= x;
             return *this;
         }
 
-        ConstIterator operator+(const difference_type x) const
+        constexpr ConstIterator operator+(const difference_type x) const
         {
             return m_ptr + x;
         }
 
-        ConstIterator operator-(const difference_type x) const
+        constexpr ConstIterator operator-(const difference_type x) const
         {
             return m_ptr - x;
         }
 
-        difference_type operator-(const ConstIterator& other) const
+        friend constexpr ConstIterator operator+(const difference_type x, const ConstIterator& it)
+        {
+            return it + x;
+        }
+
+        constexpr difference_type operator-(const ConstIterator& other) const
         {
             return m_ptr - other.m_ptr;
         }
 
-        friend bool operator==(const ConstIterator& a, const ConstIterator& other)
+        friend constexpr bool operator==(const ConstIterator& a, const ConstIterator& other)
         {
             return (a.m_ptr == other.m_ptr);
         }
 
-        friend bool operator!=(const ConstIterator& a, const ConstIterator& other)
+        friend constexpr bool operator!=(const ConstIterator& a, const ConstIterator& other)
         {
             return (a.m_ptr != other.m_ptr);
         }
 
-        friend bool operator<(const ConstIterator& a, const ConstIterator& other)
+        friend constexpr bool operator<(const ConstIterator& a, const ConstIterator& other)
         {
             return (a.m_ptr < other.m_ptr);
         }
 
-        friend bool operator>(const ConstIterator& a, const ConstIterator& other)
+        friend constexpr bool operator>(const ConstIterator& a, const ConstIterator& other)
         {
             return (a.m_ptr > other.m_ptr);
         }
 
-        friend bool operator<=(const ConstIterator& a, const ConstIterator& other)
+        friend constexpr bool operator<=(const ConstIterator& a, const ConstIterator& other)
         {
             return (a.m_ptr <= other.m_ptr);
         }
 
-        friend bool operator>=(const ConstIterator& a, const ConstIterator& other)
+        friend constexpr bool operator>=(const ConstIterator& a, const ConstIterator& other)
         {
             return (a.m_ptr >= other.m_ptr);
         }
@@ -365,114 +523,122 @@ private:
         using reference = value_type&;
 
         using iterator_category = std::random_access_iterator_tag;
-        using iterator_concept = std::contiguous_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
 
     private:
         pointer m_ptr { nullptr };
 
     public:
-        ReverseIterator(pointer ptr)
+        // Needed by std::sentinel_for, so the iterators can be used by std::ranges algorithms
+        ReverseIterator() = default;
+
+        constexpr ReverseIterator(pointer ptr)
         : m_ptr { ptr } {}
 
-        pointer operator->()
+        constexpr pointer operator->() const
         {
             return m_ptr;
         }
 
-        reference operator*() const
+        constexpr reference operator*() const
         {
             return *m_ptr;
         }
 
-        pointer data()
+        constexpr pointer data() const
         {
             return m_ptr;
         }
 
-        reference operator[](std::size_t position) const
+        constexpr reference operator[](const difference_type position) const
         {
-            return m_ptr[position];
+            return *(m_ptr - position);
         }
 
-        ReverseIterator& operator++()
+        constexpr ReverseIterator& operator++()
         {
             --m_ptr;
             return *this;
         }
 
-        ReverseIterator operator++(int)
+        constexpr ReverseIterator operator++(int)
         {
             ReverseIterator iterator { *this };
-            --(*this);
+            ++(*this);
             return iterator;
         }
 
-        ReverseIterator& operator--()
+        constexpr ReverseIterator& operator--()
         {
             ++m_ptr;
             return *this;
         }
 
-        ReverseIterator operator--(int)
+        constexpr ReverseIterator operator--(int)
         {
             ReverseIterator iterator { *this };
-            ++(*this);
+            --(*this);
             return iterator;
         }
 
-        ReverseIterator& operator+=(int x)
+        constexpr ReverseIterator& operator+=(const difference_type x)
         {
             m_ptr -= x;
             return *this;
         }
 
-        ReverseIterator& operator-=(int x)
+        constexpr ReverseIterator& operator-=(const difference_type x)
         {
             m_ptr += x;
             return *this;
         }
 
-        ReverseIterator operator+(const difference_type x) const
+        constexpr ReverseIterator operator+(const difference_type x) const
         {
             return m_ptr - x;
         }
 
-        ReverseIterator operator-(const difference_type x) const
+        constexpr ReverseIterator operator-(const difference_type x) const
         {
             return m_ptr + x;
         }
 
-        difference_type operator-(const ReverseIterator& other) const
+        friend constexpr ReverseIterator operator+(const difference_type x, const ReverseIterator& it)
         {
-            return m_ptr - other.m_ptr;
+            return it + x;
+        }
+
+        constexpr difference_type operator-(const ReverseIterator& other) const
+        {
+            return other.m_ptr - m_ptr;
         }
 
-        friend bool operator==(const ReverseIterator& a, const ReverseIterator& other)
+        friend constexpr bool operator==(const ReverseIterator& a, const ReverseIterator& other)
         {
             return (a.m_ptr == other.m_ptr);
         }
 
-        friend bool operator!=(const ReverseIterator& a, const ReverseIterator& other)
+        friend constexpr bool operator!=(const ReverseIterator& a, const ReverseIterator& other)
         {
             return (a.m_ptr != other.m_ptr);
         }
 
-        friend bool operator<(const ReverseIterator& a, const ReverseIterator& other)
+        friend constexpr bool operator<(const ReverseIterator& a, const ReverseIterator& other)
         {
             return (a.m_ptr < other.m_ptr);
         }
 
-        friend bool operator>(const ReverseIterator& a, const ReverseIterator& other)
+        friend constexpr bool operator>(const ReverseIterator& a, const ReverseIterator& other)
         {
             return (a.m_ptr > other.m_ptr);
         }
 
-        friend bool operator<=(const ReverseIterator& a, const ReverseIterator& other)
+        friend constexpr bool operator<=(const ReverseIterator& a, const ReverseIterator& other)
         {
             return (a.m_ptr <= other.m_ptr);
         }
 
-        friend bool operator>=(const ReverseIterator& a, const ReverseIterator& other)
+        friend constexpr bool operator>=(const ReverseIterator& a, const ReverseIterator& other)
         {
             return (a.m_ptr >= other.m_ptr);
         }
@@ -489,121 +655,132 @@ private:
         using difference_type = std::ptrdiff_t;
 
         using value_type = DynArray::value_type;
-        using element_type = value_type;
+        using element_type = const value_type;
 
         using pointer = const value_type*;
 
         using reference = const value_type&;
 
         using iterator_category = std::random_access_iterator_tag;
-        using iterator_concept = std::contiguous_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
 
     private:
         pointer m_ptr { nullptr };
 
     public:
-        ConstReverseIterator(pointer ptr)
+        // Needed by std::sentinel_for, so the iterators can be used by std::ranges algorithms
+        ConstReverseIterator() = default;
+
+        constexpr ConstReverseIterator(pointer ptr)
         : m_ptr { ptr } {}
 
-        pointer operator->()
+        constexpr ConstReverseIterator(const ReverseIterator& rit)
+        : m_ptr { rit.data() } {}
+
+        constexpr pointer operator->() const
         {
             return m_ptr;
         }
 
-        reference operator*() const
+        constexpr reference operator*() const
         {
             return *m_ptr;
         }
 
-        pointer data()
+        constexpr pointer data() const
         {
             return m_ptr;
         }
 
-        reference operator[](std::size_t position) const
+        constexpr reference operator[](const difference_type position) const
         {
-            return m_ptr[position];
+            return *(m_ptr - position);
         }
 
-        ConstReverseIterator& operator++()
+        constexpr ConstReverseIterator& operator++()
         {
             --m_ptr;
             return *this;
         }
 
-        ConstReverseIterator operator++(int)
+        constexpr ConstReverseIterator operator++(int)
         {
             ConstReverseIterator iterator { *this };
-            --(*this);
+            ++(*this);
             return iterator;
         }
 
-        ConstReverseIterator& operator--()
+        constexpr ConstReverseIterator& operator--()
         {
             ++m_ptr;
             return *this;
         }
 
-        ConstReverseIterator operator--(int)
+        constexpr ConstReverseIterator operator--(int)
         {
             ConstReverseIterator iterator { *this };
-            ++(*this);
+            --(*this);
             return iterator;
         }
 
-        ConstReverseIterator& operator+=(int x)
+        constexpr ConstReverseIterator& operator+=(const difference_type x)
         {
             m_ptr -= x;
             return *this;
         }
 
-        ConstReverseIterator& operator-=(int x)
+        constexpr ConstReverseIterator& operator-=(const difference_type x)
         {
             m_ptr += x;
             return *this;
         }
 
-        ConstReverseIterator operator+(const difference_type x) const
+        constexpr ConstReverseIterator operator+(const difference_type x) const
         {
             return m_ptr - x;
         }
 
-        ConstReverseIterator operator-(const difference_type x) const
+        constexpr ConstReverseIterator operator-(const difference_type x) const
         {
             return m_ptr + x;
         }
 
-        difference_type operator-(const ConstReverseIterator& other) const
+        friend constexpr ConstReverseIterator operator+(const difference_type x, const ConstReverseIterator& it)
         {
-            return m_ptr - other.m_ptr;
+            return it + x;
+        }
+
+        constexpr difference_type operator-(const ConstReverseIterator& other) const
+        {
+            return other.m_ptr - m_ptr;
         }
 
-        friend bool operator==(const ConstReverseIterator& a, const ConstReverseIterator& other)
+        friend constexpr bool operator==(const ConstReverseIterator& a, const ConstReverseIterator& other)
         {
             return (a.m_ptr == other.m_ptr);
         }
 
-        friend bool operator!=(const ConstReverseIterator& a, const ConstReverseIterator& other)
+        friend constexpr bool operator!=(const ConstReverseIterator& a, const ConstReverseIterator& other)
         {
             return (a.m_ptr != other.m_ptr);
         }
 
-        friend bool operator<(const ConstReverseIterator& a, const ConstReverseIterator& other)
+        friend constexpr bool operator<(const ConstReverseIterator& a, const ConstReverseIterator& other)
         {
             return (a.m_ptr < other.m_ptr);
         }
 
-        friend bool operator>(const ConstReverseIterator& a, const ConstReverseIterator& other)
+        friend constexpr bool operator>(const ConstReverseIterator& a, const ConstReverseIterator& other)
         {
             return (a.m_ptr > other.m_ptr);
         }
 
-        friend bool operator<=(const ConstReverseIterator& a, const ConstReverseIterator& other)
+        friend constexpr bool operator<=(const ConstReverseIterator& a, const ConstReverseIterator& other)
         {
             return (a.m_ptr <= other.m_ptr);
         }
 
-        friend bool operator>=(const ConstReverseIterator& a, const ConstReverseIterator& other)
+        friend constexpr bool operator>=(const ConstReverseIterator& a, const ConstReverseIterator& other)
         {
             return (a.m_ptr >= other.m_ptr);
         }
@@ -622,20 +799,55 @@ public:
     using const_reverse_iterator = ConstReverseIterator;
 
 private:
+    // ::operator new can't be used during constant evaluation, but std::allocator can
+    static constexpr T* allocate(std::size_t element_amount)
+    {
+        if (std::is_constant_evaluated())
+        {
+            return std::allocator<T> {}.allocate(element_amount);
+        }
+
+        return static_cast<T*>(::operator new(element_amount * sizeof(T)));
+    }
+
+    static constexpr void deallocate(T* buffer, std::size_t element_amount) noexcept
+    {
+        if (std::is_constant_evaluated())
+        {
+            std::allocator<T> {}.deallocate(buffer, element_amount);
+            return;
+        }
+
+        ::operator delete(buffer, element_amount * sizeof(T));
+    }
+
+    // The messages are only printed at run time, and only when the check policy asks for them
+    template<typename... Args>
+    static constexpr void print_message(const Args&... args)
+    {
+        if constexpr (check_policy::prints_messages)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                (std::cout << ... << args);
+            }
+        }
+    }
+
     // It increases or decreases the amount of memory used and moves the existing T elements into
     // the new buffer
-    void mem_realloc(std::size_t element_amount)
+    constexpr void mem_realloc(std::size_t element_amount)
     {
         if (!has_memory())
         {
             if (element_amount == 0)
             {
-                std::cout << "The amounts of element to get memory for is 0 and there's no allocated buffer, so the buffer won't change.\n";
+                print_message("The amounts of element to get memory for is 0 and there's no allocated buffer, so the buffer won't change.\n");
                 return;
             }
 
             m_capacity = element_amount;
-            m_first_ptr = static_cast<T*>(::operator new(m_capacity * sizeof(T)));
+            m_first_ptr = allocate(m_capacity);
 
             return;
         }
@@ -647,7 +859,7 @@ private:
                 destroy_all();
             }
 
-            ::operator delete(m_first_ptr, m_capacity * sizeof(T));
+            deallocate(m_first_ptr, m_capacity);
             m_capacity = 0;
             m_first_ptr = nullptr;
             return;
@@ -655,21 +867,21 @@ private:
 
         std::size_t old_capacity { m_capacity };
         m_capacity = element_amount;
-        T* new_buffer { static_cast<T*>(::operator new(m_capacity * sizeof(T))) };
+        T* new_buffer { allocate(m_capacity) };
 
         // If size is bigger than element_amount the remaining T objects will be discarded
         if (m_size > element_amount)
         {
-            std::cout << "The size is bigger than amount of elements for reallocation. The remaining T objects will be discarded.\n";
+            print_message("The size is bigger than amount of elements for reallocation. The remaining T objects will be discarded.\n");
 
             for (std::size_t i {}; i < element_amount; i++)
             {
-                new (&new_buffer[i]) T(std::move_if_noexcept(m_first_ptr[i]));
+                std::construct_at(new_buffer + i, std::move_if_noexcept(m_first_ptr[i]));
             }
 
             for (std::size_t i {}; i < m_size; i++)
             {
-                m_first_ptr[i].~T();
+                std::destroy_at(m_first_ptr + i);
             }
         }
         // This last case is for when the DynArray is growing to a bigger buffer and capacity
@@ -679,23 +891,23 @@ private:
             {
                 for (std::size_t i {}; i < m_size; i++)
                 {
-                    new (&new_buffer[i]) T(std::move_if_noexcept(m_first_ptr[i]));
+                    std::construct_at(new_buffer + i, std::move_if_noexcept(m_first_ptr[i]));
                 }
 
                 for (std::size_t i {}; i < m_size; i++)
                 {
-                    m_first_ptr[i].~T();
+                    std::destroy_at(m_first_ptr + i);
                 }
             }
         }
 
-        ::operator delete(m_first_ptr, old_capacity * sizeof(T));
+        deallocate(m_first_ptr, old_capacity);
         m_first_ptr = new_buffer;
     }
 
     // It increases the memory used by a factor of 2 for when the DynArray is full, or
     // just 1 block of memory of size of T if the DynArray had no memory at all
-    void grow_by_2()
+    constexpr void grow_by_2()
     {
         if (m_capacity == 0)
         {
@@ -705,25 +917,157 @@ private:
 
         mem_realloc(m_capacity * 2);
 
-        std::cout << "Growing the size.\n";
+        print_message("Growing the size.\n");
+    }
+
+    // The growth path of push_back() and emplace_back(), for a full DynArray with memory. The new element is
+    // constructed in the new buffer before the old ones are moved there, because "args" can refer to one of
+    // them, like in push_back(first())
+    template<typename... Args>
+    constexpr void grow_and_emplace_back(Args&&... args)
+    {
+        std::size_t new_capacity { m_capacity * 2 };
+        T* new_buffer { allocate(new_capacity) };
+
+        std::construct_at(new_buffer + m_size, std::forward<Args>(args)...);
+
+        for (std::size_t i {}; i < m_size; i++)
+        {
+            std::construct_at(new_buffer + i, std::move_if_noexcept(m_first_ptr[i]));
+            std::destroy_at(m_first_ptr + i);
+        }
+
+        deallocate(m_first_ptr, m_capacity);
+        m_first_ptr = new_buffer;
+        m_capacity = new_capacity;
+
+        print_message("Growing the size.\n");
+    }
+
+    // It releases memory if the shrink policy says the DynArray has become too sparse. It's called
+    // after removing elements, never after adding them, so it doesn't undo a reserve_memory() by itself
+    constexpr void shrink_if_sparse()
+    {
+        if constexpr (shrink_policy::shrinks)
+        {
+            if ((m_capacity <= shrink_policy::min_capacity) || (m_size >= (m_capacity / shrink_policy::shrink_below)))
+            {
+                return;
+            }
+
+            std::size_t new_capacity { m_size * shrink_policy::shrink_to };
+
+            mem_realloc((new_capacity > shrink_policy::min_capacity) ? new_capacity : shrink_policy::min_capacity);
+        }
+    }
+
+    // Trivially copyable objects can be moved around with memmove, so there's no need to construct nor
+    // destroy them one by one when shifting elements. memmove isn't allowed during constant evaluation
+    static constexpr bool is_relocatable_with_memmove { std::is_trivially_copyable_v<T> };
+
+    static constexpr bool can_use_memmove() noexcept
+    {
+        return (is_relocatable_with_memmove && !std::is_constant_evaluated());
+    }
+
+    // Types whose operator== means the same as comparing their bytes. Floating point numbers aren't (0.0 == -0.0,
+    // NaN != NaN), and neither are classes, since their operator== can ignore some members
+    static constexpr bool is_comparable_with_memcmp { std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T> };
+
+    static constexpr bool can_compare_with_memcmp() noexcept
+    {
+        return (is_comparable_with_memcmp && !std::is_constant_evaluated());
+    }
+
+    // It moves the elements from "position" onwards "amount" spots to the right, leaving uninitialized memory
+    // in [position, position + amount). It reallocates if there's not enough capacity
+    constexpr void open_gap(std::size_t position, std::size_t amount)
+    {
+        INVARIANT_ASSERT((amount <= (std::numeric_limits<std::size_t>::max() - m_size)), "The DynArray can't hold that many elements, they would exceed the limit of std::size_t.\n");
+
+        if ((m_size + amount) > m_capacity)
+        {
+            std::size_t new_capacity { (m_capacity == 0) ? 1 : (m_capacity * 2) };
+
+            mem_realloc(((m_size + amount) > new_capacity) ? (m_size + amount) : new_capacity);
+        }
+
+        if ((amount == 0) || (position == m_size))
+        {
+            m_size += amount;
+            return;
+        }
+
+        if (can_use_memmove())
+        {
+            std::memmove(static_cast<void*>(m_first_ptr + position + amount), static_cast<const void*>(m_first_ptr + position), (m_size - position) * sizeof(T));
+        }
+        else
+        {
+            for (std::size_t i { m_size }; i > position; i--)
+            {
+                std::construct_at(m_first_ptr + (i - 1) + amount, std::move_if_noexcept(m_first_ptr[i - 1]));
+                std::destroy_at(m_first_ptr + (i - 1));
+            }
+        }
+
+        m_size += amount;
+    }
+
+    // It destroys the elements in [position, position + amount) and moves the ones after them to the left
+    constexpr void close_gap(std::size_t position, std::size_t amount)
+    {
+        for (std::size_t i { position }; i < (position + amount); i++)
+        {
+            std::destroy_at(m_first_ptr + i);
+        }
+
+        if (amount == 0)
+        {
+            return;
+        }
+
+        if (can_use_memmove())
+        {
+            std::memmove(static_cast<void*>(m_first_ptr + position), static_cast<const void*>(m_first_ptr + position + amount), (m_size - position - amount) * sizeof(T));
+        }
+        else
+        {
+            for (std::size_t i { position + amount }; i < m_size; i++)
+            {
+                std::construct_at(m_first_ptr + i - amount, std::move_if_noexcept(m_first_ptr[i]));
+                std::destroy_at(m_first_ptr + i);
+            }
+        }
+
+        m_size -= amount;
+
+        shrink_if_sparse();
+    }
+
+    constexpr std::size_t index_of(const_iterator position) const
+    {
+        BOUNDS_ASSERT(((position.data() >= m_first_ptr) && (position.data() <= (m_first_ptr + m_size))), "The iterator doesn't point to an element of this DynArray.\n");
+
+        return static_cast<std::size_t>(position.data() - m_first_ptr);
     }
 
     // It changes old_ptr with nullptr and returns the previous value of old_ptr. It doesn't handle resources
-    T* exchange_with_null(DynArray* old_object)
+    constexpr T* exchange_with_null(DynArray* old_object)
     {
         T* temp_ptr { old_object->m_first_ptr };
         old_object->m_first_ptr = nullptr;
         return temp_ptr;
     }
 
-    std::size_t exchange_size(DynArray* old_object)
+    constexpr std::size_t exchange_size(DynArray* old_object)
     {
         std::size_t temp_size { old_object->m_size };
         old_object->m_size = 0;
         return temp_size;
     }
 
-    std::size_t exchange_capacity(DynArray* old_object)
+    constexpr std::size_t exchange_capacity(DynArray* old_object)
     {
         std::size_t temp_capacity { old_object->m_capacity };
         old_object->m_capacity = 0;
@@ -731,13 +1075,13 @@ private:
     }
 
 public:
-    DynArray()
+    constexpr DynArray()
     {
-        std::cout << "Default construction\n";
+        print_message("Default construction\n");
     }
 
     // It creates a DynArray with an "amount" number of default-initialized T objects
-    explicit DynArray(std::size_t size)
+    constexpr explicit DynArray(std::size_t size)
     : m_size { size },
       m_capacity { size }
     {
@@ -747,15 +1091,15 @@ public:
 
             for (std::size_t i {}; i < m_size; i++)
             {
-                new (m_first_ptr + i) T();
+                std::construct_at(m_first_ptr + i);
             }
         }
 
-        std::cout << "Size construction\n";
+        print_message("Size construction\n");
     }
 
     // It creates a DynArray with an "amount" number of copies of "element"
-    explicit DynArray(std::size_t amount, const T& element)
+    constexpr explicit DynArray(std::size_t amount, const T& element)
     : m_size { amount },
       m_capacity { amount }
     {
@@ -765,20 +1109,20 @@ public:
 
             for (std::size_t i {}; i < m_size; i++)
             {
-                new (m_first_ptr + i) T(element);
+                std::construct_at(m_first_ptr + i, element);
             }
         }
 
-        std::cout << "Size and single element copy construction\n";
+        print_message("Size and single element copy construction\n");
     }
 
-    DynArray(const DynArray& other)
+    constexpr DynArray(const DynArray& other)
     : m_size { other.m_size },
       m_capacity { other.m_capacity }
     {
-        if ((*this) == other)
+        if (this == &other)
         {
-            std::cout << "Both DynArrays are the same object, no copy construction will be done.\n";
+            print_message("Both DynArrays are the same object, no copy construction will be done.\n");
         }
         else
         {
@@ -790,20 +1134,20 @@ public:
                 {
                     for (std::size_t i {}; i < m_size; i++)
                     {
-                        new (m_first_ptr + i) T(other[i]);
+                        std::construct_at(m_first_ptr + i, other[i]);
                     }
                 }
             }
 
-            std::cout << "Copy construction\n";
+            print_message("Copy construction\n");
 
-            std::cout << "Size: " << m_capacity << '\n';
-            std::cout << "Capacity: " << m_capacity << '\n';
-            std::cout << ((!has_memory()) ? "The buffer is nullptr\n" : "The buffer has memory assigned to it\n");
+            print_message("Size: ", m_capacity, '\n');
+            print_message("Capacity: ", m_capacity, '\n');
+            print_message((!has_memory()) ? "The buffer is nullptr\n" : "The buffer has memory assigned to it\n");
         }
     }
 
-    DynArray(std::initializer_list<T> other)
+    constexpr DynArray(std::initializer_list<T> other)
     : m_size { other.size() },
       m_capacity { other.size() }
     {
@@ -813,22 +1157,22 @@ public:
 
             for (std::size_t i {}; i < m_size; i++)
             {
-                new (m_first_ptr + i) T(other.begin()[i]);
+                std::construct_at(m_first_ptr + i, other.begin()[i]);
             }
         }
 
-        std::cout << "std::initializer_list construction\n";
+        print_message("std::initializer_list construction\n");
 
-        std::cout << "Size: " << m_capacity << '\n';
-        std::cout << "Capacity: " << m_capacity << '\n';
-        std::cout << ((!has_memory()) ? "The buffer is nullptr\n" : "The buffer has memory assigned to it\n");
+        print_message("Size: ", m_capacity, '\n');
+        print_message("Capacity: ", m_capacity, '\n');
+        print_message((!has_memory()) ? "The buffer is nullptr\n" : "The buffer has memory assigned to it\n");
     }
 
-    DynArray(DynArray&& other) noexcept
+    constexpr DynArray(DynArray&& other) noexcept
     {
-        if ((*this) == other)
+        if (this == &other)
         {
-            std::cout << "Both DynArrays are the same object, no move construction will be done.\n";
+            print_message("Both DynArrays are the same object, no move construction will be done.\n");
         }
         else
         {
@@ -841,22 +1185,22 @@ public:
             m_first_ptr = other.m_first_ptr;
             other.m_first_ptr = nullptr;
 
-            std::cout << "Move construction\n";
+            print_message("Move construction\n");
         }
     }
 
     // No reallocations unless the other DynArray object is bigger in capacity
-    DynArray& operator=(const DynArray& other)
+    constexpr DynArray& operator=(const DynArray& other)
     {
-        if ((*this) == other)
+        if (this == &other)
         {
-            std::cout << "Both DynArrays are the same object, no copy assignment will be done.\n";
+            print_message("Both DynArrays are the same object, no copy assignment will be done.\n");
             return *this;
         }
 
         for (std::size_t i {}; i < m_size; i++)
         {
-            m_first_ptr[i].~T();
+            std::destroy_at(m_first_ptr + i);
         }
 
         m_size = other.m_size;
@@ -865,31 +1209,31 @@ public:
         {
             if (has_memory())
             {
-                ::operator delete(m_first_ptr, m_capacity * sizeof(T));
+                deallocate(m_first_ptr, m_capacity);
             }
 
             m_capacity = other.m_capacity;
-            m_first_ptr = static_cast<T*>(::operator new(m_capacity * sizeof(T)));
+            m_first_ptr = allocate(m_capacity);
         }
 
         if (!is_empty())
         {
             for (std::size_t i {}; i < m_size; i++)
             {
-                new (m_first_ptr + i) T(other[i]);
+                std::construct_at(m_first_ptr + i, other[i]);
             }
         }
 
-        std::cout << "Copy assignment\n";
+        print_message("Copy assignment\n");
         return *this;
     }
 
     // No reallocations unless the other's size is bigger than the DynArray's capacity
-    DynArray& operator=(std::initializer_list<T> other)
+    constexpr DynArray& operator=(std::initializer_list<T> other)
     {
         for (std::size_t i {}; i < m_size; i++)
         {
-            m_first_ptr[i].~T();
+            std::destroy_at(m_first_ptr + i);
         }
 
         m_size = other.size();
@@ -898,36 +1242,36 @@ public:
         {
             if (has_memory())
             {
-                ::operator delete(m_first_ptr, m_capacity * sizeof(T));
+                deallocate(m_first_ptr, m_capacity);
             }
 
             m_capacity = other.size();
-            m_first_ptr = static_cast<T*>(::operator new(m_capacity * sizeof(T)));
+            m_first_ptr = allocate(m_capacity);
         }
 
         if (!is_empty())
         {
             for (std::size_t i {}; i < m_size; i++)
             {
-                new (m_first_ptr + i) T(other.begin()[i]);
+                std::construct_at(m_first_ptr + i, other.begin()[i]);
             }
         }
 
-        std::cout << "std::initializer_list assignment\n";
+        print_message("std::initializer_list assignment\n");
         return *this;
     }
 
-    DynArray& operator=(DynArray&& other) noexcept
+    constexpr DynArray& operator=(DynArray&& other) noexcept
     {
-        if ((*this) == other)
+        if (this == &other)
         {
-            std::cout << "Both DynArrays are the same object, no move assignment will be done.\n";
+            print_message("Both DynArrays are the same object, no move assignment will be done.\n");
             return *this;
         }
 
         for (std::size_t i {}; i < m_size; i++)
         {
-            m_first_ptr[i].~T();
+            std::destroy_at(m_first_ptr + i);
         }
 
         m_size = other.m_size;
@@ -935,7 +1279,7 @@ public:
 
         if (has_memory())
         {
-            ::operator delete(m_first_ptr, m_capacity * sizeof(T));
+            deallocate(m_first_ptr, m_capacity);
         }
 
         m_capacity = other.m_capacity;
@@ -944,179 +1288,229 @@ public:
         m_first_ptr = other.m_first_ptr;
         other.m_first_ptr = nullptr;
 
-        std::cout << "Move assignment\n";
+        print_message("Move assignment\n");
         return *this;
     }
 
     // It calls the destructors for all T objects and resets size back to 0.
     // It doesn't deallocate the buffer
-    void destroy_all()
+    constexpr void destroy_all()
     {
         for (std::size_t i {}; i < m_size; i++)
         {
-            m_first_ptr[i].~T();
+            std::destroy_at(m_first_ptr + i);
         }
 
         m_size = 0;
     }
 
-    ~DynArray()
+    constexpr ~DynArray()
     {
         if (has_memory())
         {
             destroy_all();
-            ::operator delete(m_first_ptr, m_capacity * sizeof(T));
+            deallocate(m_first_ptr, m_capacity);
             m_first_ptr = nullptr;
             m_capacity = 0;
         }
 
-        std::cout << "Destruction\n";
+        print_message("Destruction\n");
     }
 
-    bool is_empty() const noexcept { return (m_size == 0); }
+    constexpr bool is_empty() const noexcept { return (m_size == 0); }
 
-    bool is_full() const noexcept
+    constexpr bool is_full() const noexcept
     {
-        BASIC_ASSERT((m_size <= m_capacity), "The size of the DynArray is bigger than its capacity!\n");
+        INVARIANT_ASSERT((m_size <= m_capacity), "The size of the DynArray is bigger than its capacity!\n");
 
         return ((!is_empty()) && (m_size == m_capacity));
     }
 
-    bool has_memory() { return (m_first_ptr != nullptr); }
+    constexpr bool has_memory() const noexcept { return (m_first_ptr != nullptr); }
+
+    constexpr std::size_t size() const noexcept { return m_size; }
+
+    constexpr std::size_t capacity() const noexcept { return m_capacity; }
 
-    std::size_t size() const noexcept { return m_size; }
+    constexpr T* array_ptr() const noexcept { return m_first_ptr; }
 
-    std::size_t capacity() const noexcept { return m_capacity; }
+    // Same as array_ptr() but const-correct, it's the one used by std::ranges::data() and std::span
+    constexpr T* data() noexcept { return m_first_ptr; }
 
-    T* array_ptr() const noexcept { return m_first_ptr; }
+    constexpr const T* data() const noexcept { return m_first_ptr; }
 
-    T& operator[](std::size_t position)
+    // Only checked and hardened builds check the position
+    constexpr T& operator[](std::size_t position)
     {
+        if constexpr (check_policy::checks_subscript)
+        {
+            BASIC_ASSERT((position < m_size), "The position must be a positive number and not bigger than the size of the DynArray.\n");
+        }
+
         return m_first_ptr[position];
     }
 
-    const T& operator[](std::size_t position) const
+    constexpr const T& operator[](std::size_t position) const
     {
+        if constexpr (check_policy::checks_subscript)
+        {
+            BASIC_ASSERT((position < m_size), "The position must be a positive number and not bigger than the size of the DynArray.\n");
+        }
+
         return m_first_ptr[position];
     }
 
-    // It works the same as operator[] but it has bounds checking
-    T& at_checked(const std::size_t position)
+    // It works the same as operator[] but it has bounds checking, unless the check policy is hdsa::unchecked
+    constexpr T& at_checked(const std::size_t position)
     {
-        BASIC_ASSERT(!(is_empty()), "The DynArray is empty, you can't get elements from it.\n");
-        BASIC_ASSERT((position < m_size), "The position must be a positive number and not bigger than the size of the DynArray.\n");
+        BOUNDS_ASSERT(!(is_empty()), "The DynArray is empty, you can't get elements from it.\n");
+        BOUNDS_ASSERT((position < m_size), "The position must be a positive number and not bigger than the size of the DynArray.\n");
 
         return m_first_ptr[position];
     }
 
-    const T& at_checked(const std::size_t position) const
+    constexpr const T& at_checked(const std::size_t position) const
     {
-        BASIC_ASSERT(!(is_empty()), "The DynArray is empty, you can't get elements from it.\n");
-        BASIC_ASSERT((position < m_size), "The position must be a positive number and not bigger than the size of the DynArray.\n");
+        BOUNDS_ASSERT(!(is_empty()), "The DynArray is empty, you can't get elements from it.\n");
+        BOUNDS_ASSERT((position < m_size), "The position must be a positive number and not bigger than the size of the DynArray.\n");
 
         return m_first_ptr[position];
     }
 
-    T& first()
+    constexpr T& first()
     {
-        BASIC_ASSERT(!is_empty(), "The DynArray is empty, you can't get the first element.\n");
+        BOUNDS_ASSERT(!is_empty(), "The DynArray is empty, you can't get the first element.\n");
 
         return m_first_ptr[0];
     }
 
-    const T& first() const
+    constexpr const T& first() const
     {
-        BASIC_ASSERT(!is_empty(), "The DynArray is empty, you can't get the first element.\n");
+        BOUNDS_ASSERT(!is_empty(), "The DynArray is empty, you can't get the first element.\n");
 
         return m_first_ptr[0];
     }
 
-    T& last()
+    constexpr T& last()
     {
-        BASIC_ASSERT(!is_empty(), "The DynArray is empty, you can't get the last element.\n");
+        BOUNDS_ASSERT(!is_empty(), "The DynArray is empty, you can't get the last element.\n");
 
         return m_first_ptr[m_size - 1];
     }
 
-    const T& last() const
+    constexpr const T& last() const
     {
-        BASIC_ASSERT(!is_empty(), "The DynArray is empty, you can't get the last element.\n");
+        BOUNDS_ASSERT(!is_empty(), "The DynArray is empty, you can't get the last element.\n");
 
         return m_first_ptr[m_size - 1];
     }
 
     // Increases the buffer and capacity
-    void reserve_memory(std::size_t element_amount)
+    constexpr void reserve_memory(std::size_t element_amount)
     {
-        BASIC_ASSERT((capacity() < std::numeric_limits<std::size_t>::max()), "The DynArray has a capacity that matches the limit of std::size_t, so it cannot grow any further.\n");
+        INVARIANT_ASSERT((capacity() < std::numeric_limits<std::size_t>::max()), "The DynArray has a capacity that matches the limit of std::size_t, so it cannot grow any further.\n");
 
         if (element_amount <= m_capacity)
         {
-            std::cout << "The amounts of element to reserve is inferior or equal to the current capacity, so reserve_memory() will do nothing.\n";
+            print_message("The amounts of element to reserve is inferior or equal to the current capacity, so reserve_memory() will do nothing.\n");
             return;
         }
 
         mem_realloc(element_amount);
     }
 
-    void push_back(const T& t)
+    // Same idea as std::string::resize_and_overwrite in C++ 23. It makes sure there's room for "element_amount"
+    // elements and gives the raw buffer to "operation", which writes the elements directly into it and
+    // returns how many of them are valid, so bulk reads don't have to construct the elements first.
+    // The elements from size() to element_amount start with indeterminate values, so only trivially
+    // copyable types are allowed
+    template<typename Operation>
+    constexpr void resize_and_overwrite(std::size_t element_amount, Operation operation)
     {
-        if (m_size == std::numeric_limits<std::size_t>::max())
+        static_assert(std::is_trivially_copyable_v<T>, "resize_and_overwrite() only works with trivially copyable types.");
+
+        if (m_capacity < element_amount)
         {
-            std::cout << "The DynArray has a number of elements that matches the limit of std::size_t, so new ones cannot be added.\n";
-            return;
+            mem_realloc(element_amount);
+        }
+
+        std::size_t new_size { static_cast<std::size_t>(std::move(operation)(m_first_ptr, element_amount)) };
+
+        BOUNDS_ASSERT((new_size <= element_amount), "The operation of resize_and_overwrite() returned a size bigger than the amount of elements.\n");
+
+        m_size = new_size;
+    }
+
+    constexpr void push_back(const T& t)
+    {
+        if constexpr (check_policy::checks_invariants)
+        {
+            if (m_size == std::numeric_limits<std::size_t>::max())
+            {
+                print_message("The DynArray has a number of elements that matches the limit of std::size_t, so new ones cannot be added.\n");
+                return;
+            }
         }
 
         if (!has_memory())
         {
             mem_realloc(1);
-            new (m_first_ptr) T(t);
+            std::construct_at(m_first_ptr, t);
             m_size++;
             return;
         }
 
         if (is_full())
         {
-            std::cout << "The DynArray is full. Growing it up.\n";
-            grow_by_2();
+            print_message("The DynArray is full. Growing it up.\n");
+            grow_and_emplace_back(t);
+        }
+        else
+        {
+            std::construct_at(m_first_ptr + m_size, t);
         }
 
-        new (m_first_ptr + m_size) T(t);
         m_size++;
     }
 
-    void push_back(T&& t)
+    constexpr void push_back(T&& t)
     {
-        if (m_size == std::numeric_limits<std::size_t>::max())
+        if constexpr (check_policy::checks_invariants)
         {
-            std::cout << "The DynArray has a number of elements that matches the limit of std::size_t, so new ones cannot be added.\n";
-            return;
+            if (m_size == std::numeric_limits<std::size_t>::max())
+            {
+                print_message("The DynArray has a number of elements that matches the limit of std::size_t, so new ones cannot be added.\n");
+                return;
+            }
         }
 
         if (!has_memory())
         {
             mem_realloc(1);
-            new (m_first_ptr) T(std::move_if_noexcept(t));
+            std::construct_at(m_first_ptr, std::move_if_noexcept(t));
             m_size++;
             return;
         }
 
         if (is_full())
         {
-            std::cout << "The DynArray is full. Growing it up.\n";
-            grow_by_2();
+            print_message("The DynArray is full. Growing it up.\n");
+            grow_and_emplace_back(std::move_if_noexcept(t));
+        }
+        else
+        {
+            std::construct_at(m_first_ptr + m_size, std::move_if_noexcept(t));
         }
 
-        new (m_first_ptr + m_size) T(std::move_if_noexcept(t));
         m_size++;
     }
 
     // In-place construction, so no copy nor move operations for inserting the new T object
     // It's often faster unless reallocations are done
     template<typename... Args>
-    T& emplace_back(Args&&... args)
+    constexpr T& emplace_back(Args&&... args)
     {
-        BASIC_ASSERT((m_size < std::numeric_limits<std::size_t>::max()), "The DynArray has a number of elements that matches the limit of std::size_t, so new ones cannot be added.\n");
+        INVARIANT_ASSERT((m_size < std::numeric_limits<std::size_t>::max()), "The DynArray has a number of elements that matches the limit of std::size_t, so new ones cannot be added.\n");
 
         if (!has_memory())
         {
@@ -1125,40 +1519,225 @@ public:
 
         if (is_full())
         {
-            std::cout << "The DynArray is full. Growing it up.\n";
-            grow_by_2();
+            print_message("The DynArray is full. Growing it up.\n");
+            grow_and_emplace_back(std::forward<Args>(args)...);
+        }
+        else
+        {
+            std::construct_at(m_first_ptr + m_size, std::forward<Args>(args)...);
         }
 
-        new (m_first_ptr + m_size) T(std::forward<Args>(args)...);
         m_size++;
 
-        std::cout << "Pushing one element with in-place construction.\n";
+        print_message("Pushing one element with in-place construction.\n");
 
         return m_first_ptr[m_size - 1];
     }
 
-    void pop_back()
+    constexpr void pop_back()
     {
         if (is_empty())
         {
-            std::cout << "The DynArray is already empty, no elements will be popped out.\n";
+            print_message("The DynArray is already empty, no elements will be popped out.\n");
             return;
         }
 
         m_size--;
-        m_first_ptr[m_size].~T();
+        std::destroy_at(m_first_ptr + m_size);
+
+        shrink_if_sparse();
+    }
+
+    // Inserts a copy of "t" before "position" and returns an iterator to it. The elements after it are shifted
+    // to the right, with memmove when T is trivially copyable
+    constexpr iterator insert(const_iterator position, const T& t)
+    {
+        return emplace(position, t);
+    }
+
+    constexpr iterator insert(const_iterator position, T&& t)
+    {
+        return emplace(position, std::move(t));
+    }
+
+    // Inserts "amount" copies of "t" before "position" and returns an iterator to the first one
+    constexpr iterator insert(const_iterator position, std::size_t amount, const T& t)
+    {
+        std::size_t index { index_of(position) };
+
+        // "t" could be an element of this same DynArray, so it's copied before anything gets moved
+        T copy(t);
+
+        open_gap(index, amount);
+
+        for (std::size_t i { index }; i < (index + amount); i++)
+        {
+            std::construct_at(m_first_ptr + i, copy);
+        }
+
+        return iterator(m_first_ptr + index);
+    }
+
+    constexpr iterator insert(const_iterator position, std::initializer_list<T> other)
+    {
+        std::size_t index { index_of(position) };
+
+        open_gap(index, other.size());
+
+        for (std::size_t i {}; i < other.size(); i++)
+        {
+            std::construct_at(m_first_ptr + index + i, other.begin()[i]);
+        }
+
+        return iterator(m_first_ptr + index);
+    }
+
+    // In-place construction before "position"
+    template<typename... Args>
+    constexpr iterator emplace(const_iterator position, Args&&... args)
+    {
+        std::size_t index { index_of(position) };
+
+        // The arguments could refer to elements of this same DynArray, so the new T object is made first
+        T t(std::forward<Args>(args)...);
+
+        open_gap(index, 1);
+        std::construct_at(m_first_ptr + index, std::move(t));
+
+        return iterator(m_first_ptr + index);
+    }
+
+    // Removes the element at "position" keeping the order of the rest, and returns an iterator to the
+    // element that followed it
+    constexpr iterator erase(const_iterator position)
+    {
+        std::size_t index { index_of(position) };
+
+        BOUNDS_ASSERT((index < m_size), "The end() iterator can't be erased.\n");
+
+        close_gap(index, 1);
+
+        return iterator(m_first_ptr + index);
+    }
+
+    // Removes all the elements in [beginning, end)
+    constexpr iterator erase(const_iterator beginning, const_iterator end)
+    {
+        std::size_t first_index { index_of(beginning) };
+        std::size_t last_index { index_of(end) };
+
+        BOUNDS_ASSERT((first_index <= last_index), "The first iterator is after the second one.\n");
+
+        close_gap(first_index, last_index - first_index);
+
+        return iterator(m_first_ptr + first_index);
+    }
+
+    // O(1) removal that doesn't keep the order: the last element is moved into "position"
+    constexpr iterator unordered_erase(const_iterator position)
+    {
+        std::size_t index { index_of(position) };
+
+        BOUNDS_ASSERT((index < m_size), "The end() iterator can't be erased.\n");
+
+        std::destroy_at(m_first_ptr + index);
+        m_size--;
+
+        if (index != m_size)
+        {
+            std::construct_at(m_first_ptr + index, std::move_if_noexcept(m_first_ptr[m_size]));
+            std::destroy_at(m_first_ptr + m_size);
+        }
+
+        shrink_if_sparse();
+
+        return iterator(m_first_ptr + index);
+    }
+
+    // Removes every element for which "predicate" returns true in a single pass, compacting the ones that stay
+    // and keeping their order. "predicate" is called exactly once per element. It returns how many were removed
+    template<typename Predicate>
+    constexpr std::size_t erase_if(Predicate predicate)
+    {
+        std::size_t write {};
+
+        if (can_use_memmove())
+        {
+            // Whole runs of kept elements are moved at once. The element that ends a run has already been
+            // tested, so its result is carried into the next run instead of calling "predicate" again
+            auto is_removed { [&](std::size_t position)
+            {
+                return ((position < m_size) && predicate(std::as_const(m_first_ptr[position])));
+            } };
+
+            std::size_t read {};
+            bool is_read_removed { is_removed(read) };
+
+            while (read < m_size)
+            {
+                while (is_read_removed)
+                {
+                    read++;
+                    is_read_removed = is_removed(read);
+                }
+
+                std::size_t run_start { read };
+
+                while ((read < m_size) && !is_read_removed)
+                {
+                    read++;
+                    is_read_removed = is_removed(read);
+                }
+
+                if (run_start != write)
+                {
+                    std::memmove(static_cast<void*>(m_first_ptr + write), static_cast<const void*>(m_first_ptr + run_start), (read - run_start) * sizeof(T));
+                }
+
+                write += read - run_start;
+            }
+        }
+        else
+        {
+            for (std::size_t read {}; read < m_size; read++)
+            {
+                if (predicate(std::as_const(m_first_ptr[read])))
+                {
+                    std::destroy_at(m_first_ptr + read);
+                    continue;
+                }
+
+                // Like the rest of the DynArray, elements are relocated with move construction, so T
+                // doesn't need to be move assignable
+                if (read != write)
+                {
+                    std::construct_at(m_first_ptr + write, std::move_if_noexcept(m_first_ptr[read]));
+                    std::destroy_at(m_first_ptr + read);
+                }
+
+                write++;
+            }
+        }
+
+        std::size_t removed { m_size - write };
+        m_size = write;
+
+        shrink_if_sparse();
+
+        return removed;
     }
 
     // Changes the size of the DynArray and creates default-constructed T objects if element_amount
     // is bigger than the DynArray size in the remaining spots.
     // It will reallocate if element_ammount is bigger than the capacity of the DynArray
-    void resize(std::size_t element_amount)
+    constexpr void resize(std::size_t element_amount)
     {
-        BASIC_ASSERT((m_size <= m_capacity), "The size of the DynArray is bigger than its capacity!\n");
+        INVARIANT_ASSERT((m_size <= m_capacity), "The size of the DynArray is bigger than its capacity!\n");
 
         if (element_amount == 0)
         {
             destroy_all();
+            shrink_if_sparse();
             return;
         }
 
@@ -1171,30 +1750,37 @@ public:
         {
             for (std::size_t i { m_size }; i < element_amount; i++)
             {
-                new(m_first_ptr + i) T();
+                std::construct_at(m_first_ptr + i);
             }
         }
         else
         {
             for (std::size_t i { element_amount }; i < m_size; i++)
             {
-                m_first_ptr[i].~T();
+                std::destroy_at(m_first_ptr + i);
             }
         }
 
+        bool has_shrunk { element_amount < m_size };
         m_size = element_amount;
+
+        if (has_shrunk)
+        {
+            shrink_if_sparse();
+        }
     }
 
     // Changes the size of the DynArray and creates copies of "value" T objects if element_amount
     // is bigger than the DynArray size in the remaining spots.
     // It will reallocate if element_ammount is bigger than the capacity of the DynArray
-    void resize(std::size_t element_amount, const T& value)
+    constexpr void resize(std::size_t element_amount, const T& value)
     {
-        BASIC_ASSERT((m_size <= m_capacity), "The size of the DynArray is bigger than its capacity!\n");
+        INVARIANT_ASSERT((m_size <= m_capacity), "The size of the DynArray is bigger than its capacity!\n");
 
         if (element_amount == 0)
         {
             destroy_all();
+            shrink_if_sparse();
             return;
         }
 
@@ -1207,24 +1793,30 @@ public:
         {
             for (std::size_t i { m_size }; i < element_amount; i++)
             {
-                new(m_first_ptr + i) T(value);
+                std::construct_at(m_first_ptr + i, value);
             }
         }
         else
         {
             for (std::size_t i { element_amount }; i < m_size; i++)
             {
-                m_first_ptr[i].~T();
+                std::destroy_at(m_first_ptr + i);
             }
         }
 
+        bool has_shrunk { element_amount < m_size };
         m_size = element_amount;
+
+        if (has_shrunk)
+        {
+            shrink_if_sparse();
+        }
     }
 
     // Makes a reallocation to use a new smaller buffer just big enough to fit all the existing elements
-    void shrink_to_size()
+    constexpr void shrink_to_size()
     {
-        BASIC_ASSERT((m_size <= m_capacity), "The size of the DynArray is bigger than its capacity!\n");
+        INVARIANT_ASSERT((m_size <= m_capacity), "The size of the DynArray is bigger than its capacity!\n");
 
         if (m_size == 0)
         {
@@ -1234,7 +1826,7 @@ public:
 
         if (is_full())
         {
-            std::cout << "The DynArray is already using only the necessary memory to contain all its elements, so nothing will be done.\n";
+            print_message("The DynArray is already using only the necessary memory to contain all its elements, so nothing will be done.\n");
             return;
         }
 
@@ -1243,71 +1835,71 @@ public:
 
     // It deletes a single element at "position" and replaces it with a default-initialized T object
     // position can go from 0 to (size() - 1)
-    void reset_single(std::size_t position)
+    constexpr void reset_single(std::size_t position)
     {
-        BASIC_ASSERT((m_size <= m_capacity), "The size of the DynArray is bigger than its capacity!\n");
+        INVARIANT_ASSERT((m_size <= m_capacity), "The size of the DynArray is bigger than its capacity!\n");
 
         if (!has_memory())
         {
-            std::cout << "There's no buffer, so no elements can be reset.\n";
+            print_message("There's no buffer, so no elements can be reset.\n");
             return;
         }
 
         if (position >= m_size)
         {
-            std::cout << "The element to delete is on a position bigger than the size of the DynArray.\n";
+            print_message("The element to delete is on a position bigger than the size of the DynArray.\n");
             return;
         }
 
-        m_first_ptr[position].~T();
-        new (m_first_ptr + position) T();
+        std::destroy_at(m_first_ptr + position);
+        std::construct_at(m_first_ptr + position);
     }
 
     // It deletes all the elements from "beginning" to "end", and replaces them with default-initialized T objects
     // The range for both parameters can go from 0 to (size() - 1), and using the same number for both resets only one T object
-    void reset_multiple(std::size_t beginning, std::size_t end)
+    constexpr void reset_multiple(std::size_t beginning, std::size_t end)
     {
-        BASIC_ASSERT((m_size <= m_capacity), "The size of the DynArray is bigger than its capacity!\n");
+        INVARIANT_ASSERT((m_size <= m_capacity), "The size of the DynArray is bigger than its capacity!\n");
 
         if (!has_memory())
         {
-            std::cout << "There's no buffer, so no elements can be reset.\n";
+            print_message("There's no buffer, so no elements can be reset.\n");
             return;
         }
 
         if (end >= m_size)
         {
-            std::cout << "The last element to delete is on a position bigger than the size of the DynArray.\n";
+            print_message("The last element to delete is on a position bigger than the size of the DynArray.\n");
             return;
         }
 
         if (beginning > end)
         {
-            std::cout << "The first position is bigger than the second one. Nothing will be done\n";
+            print_message("The first position is bigger than the second one. Nothing will be done\n");
             return;
         }
 
         for (std::size_t i { beginning }; i <= end; i++)
         {
-            m_first_ptr[i].~T();
-            new (m_first_ptr + i) T();
+            std::destroy_at(m_first_ptr + i);
+            std::construct_at(m_first_ptr + i);
         }
     }
 
     // It deletes all the elements in the DynArray, and replaces them with default-initialized T objects
-    void reset_all()
+    constexpr void reset_all()
     {
-        BASIC_ASSERT((m_size <= m_capacity), "The size of the DynArray is bigger than its capacity!\n");
+        INVARIANT_ASSERT((m_size <= m_capacity), "The size of the DynArray is bigger than its capacity!\n");
 
         if (!has_memory())
         {
-            std::cout << "There's no buffer, so no elements can be reset.\n";
+            print_message("There's no buffer, so no elements can be reset.\n");
             return;
         }
 
         if (m_size == 0)
         {
-            std::cout << "The DynArray is empty, no elements can be reset.\n";
+            print_message("The DynArray is empty, no elements can be reset.\n");
             return;
         }
 
@@ -1317,16 +1909,16 @@ public:
 
         for (std::size_t i {}; i < m_size; i++)
         {
-            m_first_ptr[i].~T();
-            new (m_first_ptr + i) T();
+            std::destroy_at(m_first_ptr + i);
+            std::construct_at(m_first_ptr + i);
         }
     }
 
     // Unlike the other "reset" member functions, this one destroys all the T objects but doesn't replace them with new ones.
     // Also, it sets size and capacity to 0, and deallocates the buffer
-    void reset_array()
+    constexpr void reset_array()
     {
-        BASIC_ASSERT((m_size <= m_capacity), "The size of the DynArray is bigger than its capacity!\n");
+        INVARIANT_ASSERT((m_size <= m_capacity), "The size of the DynArray is bigger than its capacity!\n");
 
         if (!is_empty())
         {
@@ -1335,104 +1927,172 @@ public:
 
         if (has_memory())
         {
-            ::operator delete(m_first_ptr, m_capacity * sizeof(T));
+            deallocate(m_first_ptr, m_capacity);
             m_first_ptr = nullptr;
         }
 
         m_capacity = 0;
     }
 
+    // It prints "DynArray { 1, 2, 3 }", or "DynArray { }" when empty, without a newline after it. For
+    // big arrays of numbers, NumberDumper in dyn_array_format.hpp is much faster
     friend std::ostream& operator <<(std::ostream& out, const DynArray& dyn)
     {
-        if (dyn.is_empty())
-        {
-            out << "The DynArray is empty, cannot print any elements.\n";
-            return out;
-        }
-
         out << "DynArray { ";
 
-        for (std::size_t i {}; i < (dyn.size() - 1); i++)
+        for (std::size_t i {}; i < dyn.m_size; i++)
         {
-            out << dyn[i] << ", ";
+            if (i != 0)
+            {
+                out << ", ";
+            }
+
+            out << dyn.m_first_ptr[i];
         }
 
-        out << dyn[dyn.size() - 1] << " }\n\n";
+        out << (dyn.is_empty() ? "}" : " }");
 
         return out;
     }
 
-    friend bool operator==(const DynArray<T>& a, const DynArray<T>& b)
+    // True if both DynArrays use the same buffer with the same size and capacity, which is what operator==
+    // used to check before it compared the elements
+    constexpr bool same_storage(const DynArray& other) const noexcept
     {
-        if ((a.m_first_ptr == b.m_first_ptr) && (a.m_capacity == b.m_capacity) && (a.m_size == b.m_size)) { return true; }
-
-        return false;
+        return ((m_first_ptr == other.m_first_ptr) && (m_capacity == other.m_capacity) && (m_size == other.m_size));
     }
 
-    friend bool operator!=(const DynArray<T>& a, const DynArray<T>& b)
+    // Element by element equality, operator!= comes from it. Different sizes are rejected before looking
+    // at any element, and integers, enums and pointers are compared with memcmp. Only for those a DynArray
+    // is equal to itself without comparing, since a NaN isn't equal to itself
+    friend constexpr bool operator==(const DynArray& a, const DynArray& b)
     {
-        if ((a.m_first_ptr != b.m_first_ptr) || (a.m_capacity != b.m_capacity) || (a.m_size != b.m_size)) { return true; }
+        if (a.m_size != b.m_size)
+        {
+            return false;
+        }
+
+        if (a.m_size == 0)
+        {
+            return true;
+        }
+
+        if constexpr (is_comparable_with_memcmp)
+        {
+            if (a.m_first_ptr == b.m_first_ptr)
+            {
+                return true;
+            }
+        }
+
+        if (can_compare_with_memcmp())
+        {
+            return (std::memcmp(a.m_first_ptr, b.m_first_ptr, a.m_size * sizeof(T)) == 0);
+        }
 
-        return false;
+        return std::equal(a.m_first_ptr, a.m_first_ptr + a.m_size, b.m_first_ptr);
     }
 
-    iterator begin()
+    // Lexicographical comparison, like std::vector's. For memcmp-comparable types, memcmp skips the equal
+    // prefix a whole chunk at a time and only the first chunk that differs is compared element by element
+    friend constexpr auto operator<=>(const DynArray& a, const DynArray& b) requires std::three_way_comparable<T>
     {
-        BASIC_ASSERT((has_memory()), "The DynArray has no memory assigned to it, no iterators can be made from it.\n");
+        std::size_t common_size { (a.m_size < b.m_size) ? a.m_size : b.m_size };
+        std::size_t start {};
 
-        return iterator(m_first_ptr);
+        if (can_compare_with_memcmp() && (a.m_first_ptr != b.m_first_ptr))
+        {
+            constexpr std::size_t chunk_size { 64 };
+
+            while (((start + chunk_size) <= common_size) && (std::memcmp(a.m_first_ptr + start, b.m_first_ptr + start, chunk_size * sizeof(T)) == 0))
+            {
+                start += chunk_size;
+            }
+        }
+
+        for (std::size_t i { start }; i < common_size; i++)
+        {
+            if (auto order { a.m_first_ptr[i] <=> b.m_first_ptr[i] }; order != 0)
+            {
+                return order;
+            }
+        }
+
+        return static_cast<std::compare_three_way_result_t<T>>(a.m_size <=> b.m_size);
     }
 
-    iterator end()
+    // An empty DynArray gives an empty range, so begin() == end() even if there's no buffer
+    constexpr iterator begin() noexcept
     {
-        BASIC_ASSERT((has_memory()), "The DynArray has no memory assigned to it, no iterators can be made from it.\n");
+        return iterator(m_first_ptr);
+    }
 
+    constexpr iterator end() noexcept
+    {
         return iterator(m_first_ptr + m_size);
     }
 
-    const_iterator cbegin()
+    constexpr const_iterator begin() const noexcept
     {
-        BASIC_ASSERT((has_memory()), "The DynArray has no memory assigned to it, no iterators can be made from it.\n");
-
         return const_iterator(m_first_ptr);
     }
 
-    const_iterator cend()
+    constexpr const_iterator end() const noexcept
     {
-        BASIC_ASSERT((has_memory()), "The DynArray has no memory assigned to it, no iterators can be made from it.\n");
+        return const_iterator(m_first_ptr + m_size);
+    }
+
+    constexpr const_iterator cbegin() const noexcept
+    {
+        return const_iterator(m_first_ptr);
+    }
 
+    constexpr const_iterator cend() const noexcept
+    {
         return const_iterator(m_first_ptr + m_size);
     }
 
-    reverse_iterator rbegin()
+    constexpr reverse_iterator rbegin()
     {
-        BASIC_ASSERT((has_memory()), "The DynArray has no memory assigned to it, no iterators can be made from it.\n");
+        BOUNDS_ASSERT((has_memory()), "The DynArray has no memory assigned to it, no iterators can be made from it.\n");
 
         return reverse_iterator(m_first_ptr + (m_size - 1));
     }
 
-    reverse_iterator rend()
+    constexpr reverse_iterator rend()
     {
-        BASIC_ASSERT((has_memory()), "The DynArray has no memory assigned to it, no iterators can be made from it.\n");
+        BOUNDS_ASSERT((has_memory()), "The DynArray has no memory assigned to it, no iterators can be made from it.\n");
 
         return reverse_iterator(m_first_ptr - 1);
     }
 
-    const_reverse_iterator crbegin()
+    constexpr const_reverse_iterator crbegin() const
     {
-        BASIC_ASSERT((has_memory()), "The DynArray has no memory assigned to it, no iterators can be made from it.\n");
+        BOUNDS_ASSERT((has_memory()), "The DynArray has no memory assigned to it, no iterators can be made from it.\n");
 
         return const_reverse_iterator(m_first_ptr + (m_size - 1));
     }
 
-    const_reverse_iterator crend()
+    constexpr const_reverse_iterator crend() const
     {
-        BASIC_ASSERT((has_memory()), "The DynArray has no memory assigned to it, no iterators can be made from it.\n");
+        BOUNDS_ASSERT((has_memory()), "The DynArray has no memory assigned to it, no iterators can be made from it.\n");
 
         return const_reverse_iterator(m_first_ptr - 1);
     }
 };
 
+// The other containers of the library use it for their own buffers: it keeps the checks of the policy of T,
+// but it never prints, so e.g. the worker threads of a ThreadPool don't write "Growing the size." to std::cout
+template<typename T>
+using SilentDynArray = DynArray<T, silent<typename check_policy_for<T>::type>>;
+
+// Same as std::erase_if for std::vector
+template<typename T, typename CheckPolicy, typename Predicate>
+constexpr std::size_t erase_if(DynArray<T, CheckPolicy>& dyn, Predicate predicate)
+{
+    return dyn.erase_if(predicate);
+}
+
 } // namespace hdsa end
 
 #endif // DYN_ARRAY_HPP
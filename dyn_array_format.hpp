@@ -0,0 +1,124 @@
+#ifndef DYN_ARRAY_FORMAT_HPP
+#define DYN_ARRAY_FORMAT_HPP
+
+#include "dyn_array.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <charconv>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#include <version>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+/**
+ * Text output for DynArray that's faster than its operator<<, which streams the elements one by one.
+ * NumberDumper converts numbers with std::to_chars into a buffer it keeps between calls, and writes
+ * the buffer to the stream in big blocks, so dumping millions of numbers costs a few large writes instead
+ * of millions of formatted insertions.
+ * Where the standard library has range formatting, DynArray also gets a std::formatter, so
+ * std::format("{}", dyn) gives "[1, 2, 3]" and the range format specs work: "{:n}" drops the brackets
+ * and "{::x}" formats every element with the spec after the second colon.
+*/
+
+namespace hdsa
+{
+
+template<typename T>
+concept dumpable_number = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+class NumberDumper final
+{
+private:
+    // Enough room for any number written by std::to_chars, including long doubles
+    static constexpr std::size_t max_number_length { 128 };
+
+    std::unique_ptr<char[]> m_buffer {};
+    std::size_t m_buffer_size {};
+
+public:
+    explicit NumberDumper(std::size_t buffer_size = 1 << 16)
+    : m_buffer_size { (buffer_size > max_number_length) ? buffer_size : max_number_length }
+    {
+        m_buffer = std::make_unique_for_overwrite<char[]>(m_buffer_size);
+    }
+
+    // It writes the numbers separated by "separator", with no separator after the last one. Integers are
+    // written in base 10 and floating point numbers in their shortest form that reads back to the same value
+    template<dumpable_number T>
+    void write(std::ostream& out, const T* numbers, std::size_t amount, std::string_view separator = ", ")
+    {
+        char* buffer { m_buffer.get() };
+        char* buffer_end { buffer + m_buffer_size };
+        char* position { buffer };
+
+        auto flush { [&]()
+        {
+            out.write(buffer, position - buffer);
+            position = buffer;
+        } };
+
+        for (std::size_t i {}; i < amount; i++)
+        {
+            if (i != 0)
+            {
+                if (separator.size() > static_cast<std::size_t>(buffer_end - position))
+                {
+                    flush();
+                }
+
+                // A separator bigger than the whole buffer goes straight to the stream
+                if (separator.size() > m_buffer_size)
+                {
+                    out.write(separator.data(), static_cast<std::streamsize>(separator.size()));
+                }
+                else
+                {
+                    std::memcpy(position, separator.data(), separator.size());
+                    position += separator.size();
+                }
+            }
+
+            if (static_cast<std::size_t>(buffer_end - position) < max_number_length)
+            {
+                flush();
+            }
+
+            position = std::to_chars(position, buffer_end, numbers[i]).ptr;
+        }
+
+        flush();
+    }
+
+    template<dumpable_number T, typename CheckPolicy>
+    void write(std::ostream& out, const DynArray<T, CheckPolicy>& dyn, std::string_view separator = ", ")
+    {
+        write(out, dyn.data(), dyn.size(), separator);
+    }
+};
+
+// For a single dump, NumberDumper avoids allocating the buffer again for every one
+template<dumpable_number T, typename CheckPolicy>
+void dump_numbers(std::ostream& out, const DynArray<T, CheckPolicy>& dyn, std::string_view separator = ", ")
+{
+    NumberDumper dumper {};
+    dumper.write(out, dyn, separator);
+}
+
+} // namespace hdsa end
+
+#if defined(__cpp_lib_format_ranges)
+
+// The standard range formatter already implements every range format spec
+template<typename T, typename CheckPolicy>
+requires std::formattable<T, char>
+struct std::formatter<hdsa::DynArray<T, CheckPolicy>, char> : std::range_formatter<T, char> {};
+
+#endif
+
+#endif // DYN_ARRAY_FORMAT_HPP
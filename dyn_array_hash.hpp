@@ -0,0 +1,193 @@
+#ifndef DYN_ARRAY_HASH_HPP
+#define DYN_ARRAY_HASH_HPP
+
+#include "dyn_array.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+/**
+ * Content hashing for DynArray, so it can be used as the key of hash maps (std::unordered_map,
+ * hdsa::FlatHashMap, etc.) and content-addressed caches.
+ * hash_bytes() is a non-cryptographic hash in the style of wyhash: every step multiplies two 64 bits
+ * words into a 128 bits result and folds it, long inputs are consumed 48 bytes at a time with 3 independent
+ * lanes, and short inputs need only a couple of unaligned reads. It runs at several bytes per cycle without
+ * SIMD instructions, which keeps it portable. The results depend on the endianness of the machine, so they
+ * shouldn't be stored or sent anywhere.
+ * Elements whose operator== means comparing their bytes are hashed as one block of bytes, and the rest
+ * combine the std::hash of every element.
+*/
+
+namespace hdsa
+{
+
+namespace hash_detail
+{
+
+inline constexpr std::uint64_t secret[4] { 0x2D358DCCAA6C78A5ULL, 0x8BB84B93962EACC9ULL, 0x4B33A62ED433D4A3ULL, 0x4D5A2DA51DE1AA47ULL };
+
+// The 128 bits product of a and b, folded into 64 bits
+inline std::uint64_t multiply_fold(std::uint64_t a, std::uint64_t b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ using uint128 = unsigned __int128;
+
+    uint128 product { static_cast<uint128>(a) * b };
+
+    return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+    std::uint64_t a_low { a & 0xFFFFFFFFULL };
+    std::uint64_t a_high { a >> 32 };
+    std::uint64_t b_low { b & 0xFFFFFFFFULL };
+    std::uint64_t b_high { b >> 32 };
+
+    std::uint64_t low_low { a_low * b_low };
+    std::uint64_t high_low { a_high * b_low };
+    std::uint64_t low_high { a_low * b_high };
+    std::uint64_t high_high { a_high * b_high };
+
+    std::uint64_t middle { (low_low >> 32) + (high_low & 0xFFFFFFFFULL) + low_high };
+
+    std::uint64_t low { (middle << 32) | (low_low & 0xFFFFFFFFULL) };
+    std::uint64_t high { high_high + (high_low >> 32) + (middle >> 32) };
+
+    return low ^ high;
+#endif
+}
+
+inline std::uint64_t read_64(const unsigned char* bytes) noexcept
+{
+    std::uint64_t word {};
+    std::memcpy(&word, bytes, 8);
+
+    return word;
+}
+
+inline std::uint64_t read_32(const unsigned char* bytes) noexcept
+{
+    std::uint32_t word {};
+    std::memcpy(&word, bytes, 4);
+
+    return word;
+}
+
+} // namespace hash_detail end
+
+inline std::uint64_t hash_bytes(const void* data, std::size_t byte_amount, std::uint64_t seed = 0) noexcept
+{
+    using namespace hash_detail;
+
+    const unsigned char* bytes { static_cast<const unsigned char*>(data) };
+
+    seed ^= multiply_fold(seed ^ secret[0], secret[1]);
+
+    std::uint64_t a {};
+    std::uint64_t b {};
+
+    if (byte_amount <= 16)
+    {
+        // 4 to 16 bytes: two overlapping reads from each end cover them all
+        if (byte_amount >= 4)
+        {
+            std::size_t middle { (byte_amount >> 3) << 2 };
+
+            a = (read_32(bytes) << 32) | read_32(bytes + middle);
+            b = (read_32(bytes + byte_amount - 4) << 32) | read_32(bytes + byte_amount - 4 - middle);
+        }
+        else if (byte_amount > 0)
+        {
+            a = (static_cast<std::uint64_t>(bytes[0]) << 16) | (static_cast<std::uint64_t>(bytes[byte_amount >> 1]) << 8) | bytes[byte_amount - 1];
+        }
+    }
+    else
+    {
+        std::size_t remaining { byte_amount };
+
+        if (remaining > 48)
+        {
+            std::uint64_t lane_1 { seed };
+            std::uint64_t lane_2 { seed };
+
+            do
+            {
+                seed = multiply_fold(read_64(bytes) ^ secret[1], read_64(bytes + 8) ^ seed);
+                lane_1 = multiply_fold(read_64(bytes + 16) ^ secret[2], read_64(bytes + 24) ^ lane_1);
+                lane_2 = multiply_fold(read_64(bytes + 32) ^ secret[3], read_64(bytes + 40) ^ lane_2);
+
+                bytes += 48;
+                remaining -= 48;
+            }
+            while (remaining > 48);
+
+            seed ^= lane_1 ^ lane_2;
+        }
+
+        while (remaining > 16)
+        {
+            seed = multiply_fold(read_64(bytes) ^ secret[1], read_64(bytes + 8) ^ seed);
+
+            bytes += 16;
+            remaining -= 16;
+        }
+
+        // The last 16 bytes, overlapping with the ones already hashed if needed
+        a = read_64(bytes + remaining - 16);
+        b = read_64(bytes + remaining - 8);
+    }
+
+    return multiply_fold(secret[1] ^ static_cast<std::uint64_t>(byte_amount), multiply_fold(a ^ secret[1], b ^ seed));
+}
+
+// True for the types whose operator== means the same as comparing their bytes, so hashing their bytes
+// is consistent with it. Floating point numbers aren't (0.0 == -0.0), and neither are classes in general.
+// It can be specialized for classes without padding whose operator== compares every member, like this:
+// template<> struct hdsa::is_bytewise_hashable<Point> : std::true_type {};
+template<typename T>
+struct is_bytewise_hashable : std::bool_constant<std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>> {};
+
+// The hash of "amount" elements: a single hash_bytes() call for bytewise hashable types, or the std::hash
+// of every element mixed one after the other for the rest
+template<typename T>
+std::uint64_t hash_elements(const T* elements, std::size_t amount, std::uint64_t seed = 0)
+{
+    if constexpr (is_bytewise_hashable<T>::value)
+    {
+        return hash_bytes(elements, amount * sizeof(T), seed);
+    }
+    else
+    {
+        using namespace hash_detail;
+
+        std::uint64_t hash { seed ^ secret[0] };
+
+        for (std::size_t i {}; i < amount; i++)
+        {
+            hash = multiply_fold(hash ^ secret[1], static_cast<std::uint64_t>(std::hash<T> {}(elements[i])) ^ secret[2]);
+        }
+
+        return multiply_fold(hash ^ secret[3], static_cast<std::uint64_t>(amount) ^ secret[1]);
+    }
+}
+
+template<typename T, typename CheckPolicy>
+std::uint64_t hash_elements(const DynArray<T, CheckPolicy>& dyn, std::uint64_t seed = 0)
+{
+    return hash_elements(dyn.data(), dyn.size(), seed);
+}
+
+} // namespace hdsa end
+
+// Consistent with the element by element operator== of DynArray
+template<typename T, typename CheckPolicy>
+struct std::hash<hdsa::DynArray<T, CheckPolicy>>
+{
+    std::size_t operator()(const hdsa::DynArray<T, CheckPolicy>& dyn) const
+    {
+        return static_cast<std::size_t>(hdsa::hash_elements(dyn));
+    }
+};
+
+#endif // DYN_ARRAY_HASH_HPP
@@ -0,0 +1,241 @@
+#ifndef DYN_ARRAY_PARSE_HPP
+#define DYN_ARRAY_PARSE_HPP
+
+#include "dyn_array.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <cerrno>
+#include <bit>
+#include <charconv>
+#include <memory>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+/**
+ * Bulk parsing of numeric text (e.g. the columns of a CSV file) into a DynArray, without iostreams.
+ * The numbers are separated by a delimiter or by newlines, and spaces, tabs and '\r' around them are ignored,
+ * as well as empty fields. Before parsing, the separators are counted 16 bytes at a time with SSE2, which
+ * gives an upper bound of the amount of numbers, so the DynArray is resized only once and the numbers are
+ * converted with std::from_chars straight into its buffer.
+ * All of them append to the DynArray and return false if some text isn't a number, keeping the numbers
+ * parsed before it.
+*/
+
+namespace hdsa
+{
+
+template<typename T>
+concept parsable_number = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+namespace parse_detail
+{
+
+inline bool is_separator(char c, char delimiter) noexcept
+{
+    return ((c == delimiter) || (c == '\n'));
+}
+
+// The delimiter itself can be a space or a tab, and then it isn't blank
+inline bool is_blank(char c, char delimiter) noexcept
+{
+    return (((c == ' ') || (c == '\t') || (c == '\r')) && (c != delimiter));
+}
+
+// How many bytes are either "delimiter" or a newline
+inline std::size_t count_separators(const char* text, std::size_t size, char delimiter) noexcept
+{
+    std::size_t count {};
+    std::size_t i {};
+
+#if defined(__SSE2__) || defined(_M_X64)
+    const __m128i delimiters { _mm_set1_epi8(delimiter) };
+    const __m128i newlines { _mm_set1_epi8('\n') };
+
+    for (; (i + 16) <= size; i += 16)
+    {
+        __m128i bytes { _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i)) };
+        __m128i matches { _mm_or_si128(_mm_cmpeq_epi8(bytes, delimiters), _mm_cmpeq_epi8(bytes, newlines)) };
+
+        count += static_cast<std::size_t>(std::popcount(static_cast<unsigned int>(_mm_movemask_epi8(matches))));
+    }
+#endif
+
+    for (; i < size; i++)
+    {
+        count += static_cast<std::size_t>(is_separator(text[i], delimiter));
+    }
+
+    return count;
+}
+
+// It parses all of "text", which must not end in the middle of a number. "offset" is where "text" starts
+// in the whole input, for the error message
+template<parsable_number T, typename CheckPolicy>
+bool parse_block(DynArray<T, CheckPolicy>& dyn, const char* text, std::size_t size, char delimiter, std::size_t offset)
+{
+    // Every number is followed by a separator or by the end of the text
+    std::size_t max_numbers { count_separators(text, size, delimiter) + 1 };
+    std::size_t old_size { dyn.size() };
+    std::size_t needed { old_size + max_numbers };
+
+    // Growing geometrically, so parsing a stream chunk after chunk doesn't reallocate for every chunk
+    if (needed > dyn.capacity())
+    {
+        dyn.reserve_memory((needed > (dyn.capacity() * 2)) ? needed : (dyn.capacity() * 2));
+    }
+
+    const char* position { text };
+    const char* end { text + size };
+    bool is_valid { true };
+
+    dyn.resize_and_overwrite(needed, [&](T* buffer, std::size_t)
+    {
+        std::size_t count { old_size };
+
+        while (true)
+        {
+            while ((position != end) && is_blank(*position, delimiter))
+            {
+                position++;
+            }
+
+            if (position == end)
+            {
+                break;
+            }
+
+            // Empty fields and blank lines are skipped
+            if (is_separator(*position, delimiter))
+            {
+                position++;
+                continue;
+            }
+
+            auto [number_end, error] { std::from_chars(position, end, buffer[count]) };
+
+            if (error != std::errc {})
+            {
+                is_valid = false;
+                break;
+            }
+
+            count++;
+            position = number_end;
+
+            while ((position != end) && is_blank(*position, delimiter))
+            {
+                position++;
+            }
+
+            if ((position != end) && !is_separator(*position, delimiter))
+            {
+                is_valid = false;
+                break;
+            }
+        }
+
+        return count;
+    });
+
+    if (!is_valid)
+    {
+        std::cerr << "The text at byte " << (offset + static_cast<std::size_t>(position - text)) << " is not a valid number.\n";
+    }
+
+    return is_valid;
+}
+
+} // namespace parse_detail end
+
+template<parsable_number T, typename CheckPolicy>
+bool parse_into(DynArray<T, CheckPolicy>& dyn, std::string_view text, char delimiter = ',')
+{
+    return parse_detail::parse_block(dyn, text.data(), text.size(), delimiter, 0);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+// The streaming version reads the file descriptor in chunks of "chunk_size" bytes, and every chunk
+// is parsed up to its last separator. The rest is kept for the next chunk, since it can be a number
+// that continues there
+template<parsable_number T, typename CheckPolicy>
+bool parse_into(DynArray<T, CheckPolicy>& dyn, int fd, char delimiter = ',', std::size_t chunk_size = 1 << 20)
+{
+    chunk_size = (chunk_size < 64) ? 64 : chunk_size;
+
+    std::unique_ptr<char[]> buffer { std::make_unique_for_overwrite<char[]>(chunk_size) };
+    std::size_t filled {};
+    std::size_t offset {};
+    bool is_end_of_file { false };
+
+    while (!is_end_of_file)
+    {
+        while (filled < chunk_size)
+        {
+            ssize_t amount_read { ::read(fd, buffer.get() + filled, chunk_size - filled) };
+
+            if (amount_read < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                std::cerr << "Reading from the file descriptor failed: " << std::strerror(errno) << '\n';
+                return false;
+            }
+
+            if (amount_read == 0)
+            {
+                is_end_of_file = true;
+                break;
+            }
+
+            filled += static_cast<std::size_t>(amount_read);
+        }
+
+        std::size_t complete { filled };
+
+        if (!is_end_of_file)
+        {
+            while ((complete > 0) && !parse_detail::is_separator(buffer[complete - 1], delimiter))
+            {
+                complete--;
+            }
+
+            if (complete == 0)
+            {
+                std::cerr << "There's a field longer than the chunk size at byte " << offset << ".\n";
+                return false;
+            }
+        }
+
+        if (!parse_detail::parse_block(dyn, buffer.get(), complete, delimiter, offset))
+        {
+            return false;
+        }
+
+        std::memmove(buffer.get(), buffer.get() + complete, filled - complete);
+        filled -= complete;
+        offset += complete;
+    }
+
+    return true;
+}
+
+#endif
+
+} // namespace hdsa end
+
+#endif // DYN_ARRAY_PARSE_HPP
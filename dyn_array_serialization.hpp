@@ -0,0 +1,466 @@
+#ifndef DYN_ARRAY_SERIALIZATION_HPP
+#define DYN_ARRAY_SERIALIZATION_HPP
+
+#include "dyn_array.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <bit>
+#include <limits>
+#include <type_traits>
+#include <iostream>
+#include <istream>
+#include <ostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Binary serialization for DynArray. Every saved DynArray starts with a small versioned header
+ * (type size, alignment, endianness, element count and a checksum) followed by the elements.
+ * Trivially copyable elements are written and read as a single block straight from and into the
+ * buffer of the DynArray, without constructing them one by one.
+ * Other types need a specialization of hdsa::ElementSerializer, which is the customization point
+ * used to write and read them one element at a time.
+*/
+
+namespace hdsa
+{
+
+// Specialize it for types that aren't trivially copyable, like this:
+// template<> struct hdsa::ElementSerializer<MyType>
+// {
+//     static bool write(std::ostream& out, const MyType& t);
+//     static bool read(std::istream& in, MyType& t);   // "t" is a default-constructed object
+// };
+template<typename T>
+struct ElementSerializer;
+
+struct SerializationHeader final
+{
+    char magic[4] { 'H', 'D', 'S', 'A' };
+    std::uint16_t version { 1 };
+    std::uint8_t big_endian { std::endian::native == std::endian::big };
+    std::uint8_t custom_elements {};  // 1 if the elements were written by an ElementSerializer
+    std::uint32_t type_size {};
+    std::uint32_t type_alignment {};
+    std::uint64_t count {};
+    std::uint64_t checksum {};        // Only computed for trivially copyable elements, 0 otherwise
+};
+
+static_assert((sizeof(SerializationHeader) == 32), "The serialization header must not have any padding.");
+
+// A fast non-cryptographic checksum that consumes 32 bytes per iteration with 4 independent lanes,
+// so it doesn't become the bottleneck of saving and loading
+inline std::uint64_t checksum_bytes(const void* data, std::size_t byte_amount) noexcept
+{
+    constexpr std::uint64_t prime_1 { 0x9E3779B185EBCA87ULL };
+    constexpr std::uint64_t prime_2 { 0xC2B2AE3D27D4EB4FULL };
+
+    const unsigned char* bytes { static_cast<const unsigned char*>(data) };
+    std::uint64_t lanes[4] { prime_1, prime_2, prime_1 ^ prime_2, ~prime_1 };
+    std::size_t i {};
+
+    for (; (i + 32) <= byte_amount; i += 32)
+    {
+        for (std::size_t lane {}; lane < 4; lane++)
+        {
+            std::uint64_t word {};
+            std::memcpy(&word, bytes + i + (lane * 8), 8);
+
+            lanes[lane] = std::rotl(lanes[lane] + (word * prime_2), 31) * prime_1;
+        }
+    }
+
+    std::uint64_t hash { std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18) };
+    hash += static_cast<std::uint64_t>(byte_amount);
+
+    for (; i < byte_amount; i++)
+    {
+        hash = std::rotl(hash ^ (bytes[i] * prime_1), 11) * prime_2;
+    }
+
+    hash ^= hash >> 33;
+    hash *= prime_2;
+    hash ^= hash >> 29;
+
+    return hash;
+}
+
+template<typename T, typename CheckPolicy>
+SerializationHeader make_serialization_header(const DynArray<T, CheckPolicy>& dyn)
+{
+    SerializationHeader header {};
+    header.type_size = static_cast<std::uint32_t>(sizeof(T));
+    header.type_alignment = static_cast<std::uint32_t>(alignof(T));
+    header.count = static_cast<std::uint64_t>(dyn.size());
+
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        header.checksum = checksum_bytes(dyn.data(), dyn.size() * sizeof(T));
+    }
+    else
+    {
+        header.custom_elements = 1;
+    }
+
+    return header;
+}
+
+// It makes sure a header read from a file can be loaded into a DynArray<T>
+template<typename T>
+bool check_serialization_header(const SerializationHeader& header)
+{
+    const SerializationHeader expected {};
+
+    if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0)
+    {
+        std::cerr << "The data doesn't start with a DynArray serialization header.\n";
+        return false;
+    }
+
+    if (header.version != expected.version)
+    {
+        std::cerr << "The serialization version " << header.version << " is not supported.\n";
+        return false;
+    }
+
+    if (header.big_endian != expected.big_endian)
+    {
+        std::cerr << "The data was saved on a machine with a different endianness.\n";
+        return false;
+    }
+
+    if ((header.type_size != sizeof(T)) || (header.type_alignment != alignof(T)))
+    {
+        std::cerr << "The size or alignment of the saved elements doesn't match the ones of T.\n";
+        return false;
+    }
+
+    if (header.custom_elements != (std::is_trivially_copyable_v<T> ? 0 : 1))
+    {
+        std::cerr << "The saved elements were written in a different format than the one T uses.\n";
+        return false;
+    }
+
+    return true;
+}
+
+// The element count of the header comes from the data, so a corrupt or hostile one must not make load()
+// allocate more than the data can hold. When the size of the data is known the count is checked against it
+// before allocating, and when it isn't (pipes, sockets) the elements are read in blocks that grow
+// geometrically, so the memory used stays proportional to the bytes actually read
+inline constexpr std::uint64_t unknown_size { std::numeric_limits<std::uint64_t>::max() };
+
+inline constexpr std::size_t first_block_bytes { 1 << 16 };
+
+// The bytes left from the current position to the end of the stream, or unknown_size if it can't seek
+inline std::uint64_t remaining_bytes(std::istream& in)
+{
+    std::istream::pos_type current { in.tellg() };
+
+    if (current == std::istream::pos_type(-1))
+    {
+        return unknown_size;
+    }
+
+    std::istream::pos_type end { in.seekg(0, std::ios::end).tellg() };
+
+    in.clear();
+    in.seekg(current);
+
+    if ((end == std::istream::pos_type(-1)) || (end < current))
+    {
+        return unknown_size;
+    }
+
+    return static_cast<std::uint64_t>(end - current);
+}
+
+template<typename T>
+bool check_element_count(std::uint64_t count, std::uint64_t remaining)
+{
+    if (count > (std::numeric_limits<std::size_t>::max() / sizeof(T)))
+    {
+        std::cerr << "The saved element count doesn't fit in memory.\n";
+        return false;
+    }
+
+    if (std::is_trivially_copyable_v<T> && (remaining != unknown_size) && (count > (remaining / sizeof(T))))
+    {
+        std::cerr << "The saved element count is bigger than the data that follows the header.\n";
+        return false;
+    }
+
+    return true;
+}
+
+// It fills "dyn", which must be empty, with "count" trivially copyable elements. "read_bytes" reads into
+// a buffer and returns how many bytes it got, fewer only at the end of the data
+template<typename T, typename CheckPolicy, typename Reader>
+bool read_trivial_elements(DynArray<T, CheckPolicy>& dyn, std::size_t count, std::uint64_t remaining, Reader read_bytes)
+{
+    std::size_t block { (remaining == unknown_size) ? ((first_block_bytes / sizeof(T)) + 1) : count };
+
+    while (dyn.size() < count)
+    {
+        std::size_t loaded { dyn.size() };
+        std::size_t target { ((count - loaded) < block) ? count : (loaded + block) };
+
+        dyn.resize_and_overwrite(target, [&](T* buffer, std::size_t amount)
+        {
+            return loaded + (read_bytes(buffer + loaded, (amount - loaded) * sizeof(T)) / sizeof(T));
+        });
+
+        if (dyn.size() != target)
+        {
+            std::cerr << "The data ended before all the elements could be read.\n";
+            return false;
+        }
+
+        block *= 2;
+    }
+
+    return true;
+}
+
+template<typename T, typename CheckPolicy>
+bool save(const DynArray<T, CheckPolicy>& dyn, std::ostream& out)
+{
+    SerializationHeader header { make_serialization_header(dyn) };
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        out.write(reinterpret_cast<const char*>(dyn.data()), static_cast<std::streamsize>(dyn.size() * sizeof(T)));
+    }
+    else
+    {
+        for (const T& t : dyn)
+        {
+            if (!ElementSerializer<T>::write(out, t))
+            {
+                return false;
+            }
+        }
+    }
+
+    return out.good();
+}
+
+// It replaces the contents of "dyn" with the ones saved in "in". The elements are loaded into another
+// DynArray first, so if anything fails "dyn" keeps its old contents
+template<typename T, typename CheckPolicy>
+bool load(DynArray<T, CheckPolicy>& dyn, std::istream& in)
+{
+    SerializationHeader header {};
+
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) || !check_serialization_header<T>(header))
+    {
+        return false;
+    }
+
+    std::uint64_t remaining { remaining_bytes(in) };
+
+    if (!check_element_count<T>(header.count, remaining))
+    {
+        return false;
+    }
+
+    std::size_t count { static_cast<std::size_t>(header.count) };
+    DynArray<T, CheckPolicy> loaded {};
+
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        bool is_complete { read_trivial_elements(loaded, count, remaining, [&in](T* buffer, std::size_t byte_amount)
+        {
+            in.read(reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(byte_amount));
+            return static_cast<std::size_t>(in.gcount());
+        }) };
+
+        if (!is_complete)
+        {
+            return false;
+        }
+
+        if (checksum_bytes(loaded.data(), count * sizeof(T)) != header.checksum)
+        {
+            std::cerr << "The checksum of the loaded elements doesn't match the saved one.\n";
+            return false;
+        }
+    }
+    else
+    {
+        // The size of a custom element is unknown, but every one takes at least a byte
+        std::size_t reserved { ((remaining != unknown_size) && (remaining < count)) ? static_cast<std::size_t>(remaining) : count };
+
+        if (remaining == unknown_size)
+        {
+            reserved = (reserved < first_block_bytes) ? reserved : first_block_bytes;
+        }
+
+        if (reserved > 0)
+        {
+            loaded.reserve_memory(reserved);
+        }
+
+        for (std::size_t i {}; i < count; i++)
+        {
+            T& t { loaded.emplace_back() };
+
+            if (!ElementSerializer<T>::read(in, t))
+            {
+                return false;
+            }
+        }
+    }
+
+    dyn = std::move(loaded);
+
+    return true;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+// write() and read() can handle fewer bytes than requested, so both are called until everything is done
+inline bool write_all(int fd, const void* data, std::size_t byte_amount)
+{
+    const char* bytes { static_cast<const char*>(data) };
+
+    while (byte_amount > 0)
+    {
+        ssize_t written { ::write(fd, bytes, byte_amount) };
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            std::cerr << "Writing to the file descriptor failed: " << std::strerror(errno) << '\n';
+            return false;
+        }
+
+        bytes += written;
+        byte_amount -= static_cast<std::size_t>(written);
+    }
+
+    return true;
+}
+
+inline std::size_t read_all(int fd, void* data, std::size_t byte_amount)
+{
+    char* bytes { static_cast<char*>(data) };
+    std::size_t total {};
+
+    while (total < byte_amount)
+    {
+        ssize_t amount_read { ::read(fd, bytes + total, byte_amount - total) };
+
+        if (amount_read < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            std::cerr << "Reading from the file descriptor failed: " << std::strerror(errno) << '\n';
+            break;
+        }
+
+        if (amount_read == 0)
+        {
+            break;
+        }
+
+        total += static_cast<std::size_t>(amount_read);
+    }
+
+    return total;
+}
+
+// The bytes left from the current offset to the end of a regular file, or unknown_size for pipes, sockets, etc.
+inline std::uint64_t remaining_bytes(int fd)
+{
+    struct stat file_info {};
+
+    if ((::fstat(fd, &file_info) == -1) || !S_ISREG(file_info.st_mode))
+    {
+        return unknown_size;
+    }
+
+    off_t current { ::lseek(fd, 0, SEEK_CUR) };
+
+    if ((current == -1) || (current > file_info.st_size))
+    {
+        return unknown_size;
+    }
+
+    return static_cast<std::uint64_t>(file_info.st_size - current);
+}
+
+// The file descriptor versions skip the buffering of the streams, so they only work with trivially copyable types
+template<typename T, typename CheckPolicy>
+bool save(const DynArray<T, CheckPolicy>& dyn, int fd)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Saving to a file descriptor only works with trivially copyable types, use a std::ostream instead.");
+
+    SerializationHeader header { make_serialization_header(dyn) };
+
+    return (write_all(fd, &header, sizeof(header)) && write_all(fd, dyn.data(), dyn.size() * sizeof(T)));
+}
+
+template<typename T, typename CheckPolicy>
+bool load(DynArray<T, CheckPolicy>& dyn, int fd)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Loading from a file descriptor only works with trivially copyable types, use a std::istream instead.");
+
+    SerializationHeader header {};
+
+    if ((read_all(fd, &header, sizeof(header)) != sizeof(header)) || !check_serialization_header<T>(header))
+    {
+        return false;
+    }
+
+    std::uint64_t remaining { remaining_bytes(fd) };
+
+    if (!check_element_count<T>(header.count, remaining))
+    {
+        return false;
+    }
+
+    std::size_t count { static_cast<std::size_t>(header.count) };
+    DynArray<T, CheckPolicy> loaded {};
+
+    bool is_complete { read_trivial_elements(loaded, count, remaining, [fd](T* buffer, std::size_t byte_amount)
+    {
+        return read_all(fd, buffer, byte_amount);
+    }) };
+
+    if (!is_complete)
+    {
+        return false;
+    }
+
+    if (checksum_bytes(loaded.data(), count * sizeof(T)) != header.checksum)
+    {
+        std::cerr << "The checksum of the loaded elements doesn't match the saved one.\n";
+        return false;
+    }
+
+    dyn = std::move(loaded);
+
+    return true;
+}
+
+#endif // defined(__unix__) || defined(__APPLE__)
+
+} // namespace hdsa end
+
+#endif // DYN_ARRAY_SERIALIZATION_HPP
@@ -0,0 +1,667 @@
+#ifndef FLAT_HASH_MAP_HPP
+#define FLAT_HASH_MAP_HPP
+
+#include "dyn_array.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <type_traits>
+#include <iterator>
+#include <functional>
+#include <new>
+#include <iostream>
+#include <utility>
+#include <initializer_list>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+/**
+ * Personal implementation of an open-addressing hash map, based on the "SwissTable" design.
+ * Every slot has a control byte that says if it's empty, deleted, or full, and in the last case
+ * it also keeps 7 bits of the hash of its key. The slots are probed in groups of 16 and the control
+ * bytes of a whole group are compared at once with SSE2, so most lookups only compare a key when
+ * it's very likely to be the right one.
+ * The control bytes and the slots live in two flat DynArrays, so there's no allocation per element
+ * like in std::unordered_map and iterating over it is a linear scan.
+*/
+
+namespace hdsa
+{
+
+template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class FlatHashMap final
+{
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    static constexpr std::size_t group_size { 16 };
+
+private:
+    using ctrl_t = std::int8_t;
+
+    static constexpr ctrl_t empty_ctrl { -128 };
+    static constexpr ctrl_t deleted_ctrl { -2 };
+
+    // Raw memory for a single value_type, so the slots can be allocated without constructing anything
+    struct SlotStorage final
+    {
+        alignas(value_type) unsigned char bytes[sizeof(value_type)];
+    };
+
+    // When both Hash and KeyEqual are transparent, like with the standard unordered containers, lookups
+    // can use other types than K without converting them first
+    static constexpr bool is_transparent { requires { typename Hash::is_transparent; typename KeyEqual::is_transparent; } };
+
+    template<typename Lookup>
+    static constexpr bool is_lookup_type { is_transparent || std::is_constructible_v<K, const Lookup&> };
+
+    SilentDynArray<ctrl_t> m_ctrl {};
+    SilentDynArray<SlotStorage> m_slots {};
+    std::size_t m_size {};
+    std::size_t m_growth_left {};       // How many elements can be inserted before a rehash is needed
+    [[no_unique_address]] Hash m_hash {};
+    [[no_unique_address]] KeyEqual m_equal {};
+
+    // A bitmask with one bit per slot of a group
+    using Mask = std::uint32_t;
+
+    static Mask match_byte(const ctrl_t* group, ctrl_t byte) noexcept
+    {
+#if defined(__SSE2__) || defined(_M_X64)
+        __m128i ctrl { _mm_loadu_si128(reinterpret_cast<const __m128i*>(group)) };
+        return static_cast<Mask>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(byte))));
+#else
+        Mask mask {};
+
+        for (std::size_t i {}; i < group_size; i++)
+        {
+            mask |= static_cast<Mask>(group[i] == byte) << i;
+        }
+
+        return mask;
+#endif
+    }
+
+    // Empty and deleted control bytes are the only negative ones smaller than -1
+    static Mask match_empty_or_deleted(const ctrl_t* group) noexcept
+    {
+#if defined(__SSE2__) || defined(_M_X64)
+        __m128i ctrl { _mm_loadu_si128(reinterpret_cast<const __m128i*>(group)) };
+        return static_cast<Mask>(_mm_movemask_epi8(_mm_cmplt_epi8(ctrl, _mm_set1_epi8(-1))));
+#else
+        Mask mask {};
+
+        for (std::size_t i {}; i < group_size; i++)
+        {
+            mask |= static_cast<Mask>(group[i] < -1) << i;
+        }
+
+        return mask;
+#endif
+    }
+
+    // std::hash is the identity for integers in most implementations, so the bits are mixed before
+    // splitting them into the group index (h1) and the 7 bits kept in the control byte (h2)
+    template<typename Lookup>
+    std::size_t hash_of(const Lookup& key) const
+    {
+        std::uint64_t h { static_cast<std::uint64_t>(m_hash(key)) * 0x9E3779B97F4A7C15ULL };
+        return static_cast<std::size_t>(h ^ (h >> 32));
+    }
+
+    // It converts "key" to K only when the lookup can't be heterogeneous
+    template<typename Lookup>
+    static decltype(auto) to_lookup(const Lookup& key)
+    {
+        if constexpr (is_transparent || std::is_same_v<Lookup, K>)
+        {
+            return (key);
+        }
+        else
+        {
+            return K(key);
+        }
+    }
+
+    static ctrl_t h2(std::size_t hash) noexcept { return static_cast<ctrl_t>(hash & 0x7F); }
+
+    static std::size_t h1(std::size_t hash) noexcept { return (hash >> 7); }
+
+    std::size_t group_mask() const noexcept { return (m_ctrl.size() / group_size) - 1; }
+
+    value_type* slot(std::size_t index) noexcept
+    {
+        return std::launder(reinterpret_cast<value_type*>(m_slots[index].bytes));
+    }
+
+    const value_type* slot(std::size_t index) const noexcept
+    {
+        return std::launder(reinterpret_cast<const value_type*>(m_slots[index].bytes));
+    }
+
+    static std::size_t max_load(std::size_t capacity) noexcept
+    {
+        return capacity - (capacity / 8);
+    }
+
+    // It returns the index of the slot holding "key", or capacity() if it's not in the map
+    template<typename Lookup>
+    std::size_t find_index(const Lookup& key, std::size_t hash) const
+    {
+        if (m_size == 0)
+        {
+            return capacity();
+        }
+
+        std::size_t mask { group_mask() };
+        std::size_t group { h1(hash) & mask };
+        ctrl_t tag { h2(hash) };
+
+        // Triangular probing visits every group once when the amount of groups is a power of 2
+        for (std::size_t step { 1 }; ; step++)
+        {
+            const ctrl_t* ctrl { m_ctrl.data() + (group * group_size) };
+
+            for (Mask match { match_byte(ctrl, tag) }; match != 0; match &= match - 1)
+            {
+                std::size_t index { (group * group_size) + static_cast<std::size_t>(std::countr_zero(match)) };
+
+                if (m_equal(slot(index)->first, key))
+                {
+                    return index;
+                }
+            }
+
+            if (match_byte(ctrl, empty_ctrl) != 0)
+            {
+                return capacity();
+            }
+
+            group = (group + step) & mask;
+        }
+    }
+
+    // The first empty or deleted slot in the probe sequence of "hash"
+    std::size_t find_free_index(std::size_t hash) const
+    {
+        std::size_t mask { group_mask() };
+        std::size_t group { h1(hash) & mask };
+
+        for (std::size_t step { 1 }; ; step++)
+        {
+            Mask match { match_empty_or_deleted(m_ctrl.data() + (group * group_size)) };
+
+            if (match != 0)
+            {
+                return (group * group_size) + static_cast<std::size_t>(std::countr_zero(match));
+            }
+
+            group = (group + step) & mask;
+        }
+    }
+
+    // It makes new buffers with room for "new_capacity" slots and moves every element into them
+    void rehash(std::size_t new_capacity)
+    {
+        SilentDynArray<ctrl_t> old_ctrl { std::move(m_ctrl) };
+        SilentDynArray<SlotStorage> old_slots { std::move(m_slots) };
+
+        m_ctrl = SilentDynArray<ctrl_t> {};
+        m_ctrl.resize(new_capacity, empty_ctrl);
+
+        m_slots = SilentDynArray<SlotStorage> {};
+        m_slots.resize_and_overwrite(new_capacity, [](SlotStorage*, std::size_t amount) { return amount; });
+
+        m_growth_left = max_load(new_capacity) - m_size;
+
+        for (std::size_t i {}; i < old_ctrl.size(); i++)
+        {
+            if (old_ctrl[i] < 0)
+            {
+                continue;
+            }
+
+            value_type* old_value { std::launder(reinterpret_cast<value_type*>(old_slots[i].bytes)) };
+            std::size_t hash { hash_of(old_value->first) };
+            std::size_t index { find_free_index(hash) };
+
+            m_ctrl[index] = h2(hash);
+
+            if constexpr (std::is_trivially_copyable_v<value_type>)
+            {
+                std::memcpy(m_slots[index].bytes, old_slots[i].bytes, sizeof(value_type));
+            }
+            else
+            {
+                new (m_slots[index].bytes) value_type(std::move(*old_value));
+                old_value->~value_type();
+            }
+        }
+    }
+
+    // The capacity is always a power of 2 and a multiple of the group size
+    static std::size_t capacity_for(std::size_t element_amount) noexcept
+    {
+        std::size_t capacity { group_size };
+
+        while (max_load(capacity) < element_amount)
+        {
+            capacity *= 2;
+        }
+
+        return capacity;
+    }
+
+    // It makes room for one more element, rehashing if the map is too full
+    void prepare_insert()
+    {
+        if (m_growth_left > 0)
+        {
+            return;
+        }
+
+        // When many slots are just deleted ones, rehashing with the same capacity is enough to clean them
+        std::size_t capacity_needed { capacity_for(m_size + 1) };
+        rehash((capacity_needed > capacity()) ? capacity_needed : ((capacity() == 0) ? group_size : capacity()));
+    }
+
+    template<typename Lookup, typename... Args>
+    std::pair<std::size_t, bool> try_emplace_impl(Lookup&& key, Args&&... args)
+    {
+        std::size_t hash { hash_of(key) };
+        std::size_t index { find_index(key, hash) };
+
+        if (index != capacity())
+        {
+            return { index, false };
+        }
+
+        if (m_growth_left > 0)
+        {
+            return { construct_in_free_slot(hash, std::piecewise_construct, std::forward_as_tuple(std::forward<Lookup>(key)), std::forward_as_tuple(std::forward<Args>(args)...)), true };
+        }
+
+        // The key and the arguments can refer to elements of the map (e.g. m.try_emplace(k, m[other])), which
+        // the rehash moves, so the new element is built before it
+        value_type value(std::piecewise_construct, std::forward_as_tuple(std::forward<Lookup>(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+        prepare_insert();
+
+        return { construct_in_free_slot(hash, std::move(value)), true };
+    }
+
+    // It constructs the element in the first free slot of the probe sequence of "hash", and returns its index
+    template<typename... Args>
+    std::size_t construct_in_free_slot(std::size_t hash, Args&&... args)
+    {
+        std::size_t index { find_free_index(hash) };
+
+        if (m_ctrl[index] == empty_ctrl)
+        {
+            m_growth_left--;
+        }
+
+        new (m_slots[index].bytes) value_type(std::forward<Args>(args)...);
+        m_ctrl[index] = h2(hash);
+        m_size++;
+
+        return index;
+    }
+
+    void erase_index(std::size_t index)
+    {
+        slot(index)->~value_type();
+        m_size--;
+
+        // If the group still has an empty slot no probe sequence ever went past it, so the slot can be
+        // marked as empty again instead of leaving a tombstone
+        const ctrl_t* group { m_ctrl.data() + ((index / group_size) * group_size) };
+
+        if (match_byte(group, empty_ctrl) != 0)
+        {
+            m_ctrl[index] = empty_ctrl;
+            m_growth_left++;
+        }
+        else
+        {
+            m_ctrl[index] = deleted_ctrl;
+        }
+    }
+
+    // It skips the slots that aren't full, starting at "index"
+    std::size_t next_full(std::size_t index) const noexcept
+    {
+        while ((index < capacity()) && (m_ctrl[index] < 0))
+        {
+            index++;
+        }
+
+        return index;
+    }
+
+    template<bool IsConst>
+    struct MapIterator final
+    {
+        using difference_type = std::ptrdiff_t;
+
+        using value_type = FlatHashMap::value_type;
+
+        using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+
+        using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+        using iterator_category = std::forward_iterator_tag;
+        using iterator_concept = std::forward_iterator_tag;
+
+    private:
+        using map_pointer = std::conditional_t<IsConst, const FlatHashMap*, FlatHashMap*>;
+
+        map_pointer m_map { nullptr };
+        std::size_t m_index {};
+
+        friend class FlatHashMap;
+
+    public:
+        MapIterator() = default;
+
+        MapIterator(map_pointer map, std::size_t index)
+        : m_map { map },
+          m_index { index } {}
+
+        // Every iterator can be used where a const iterator is expected
+        template<bool OtherConst>
+        requires (IsConst && !OtherConst)
+        MapIterator(const MapIterator<OtherConst>& other)
+        : m_map { other.m_map },
+          m_index { other.m_index } {}
+
+        reference operator*() const
+        {
+            return *m_map->slot(m_index);
+        }
+
+        pointer operator->() const
+        {
+            return m_map->slot(m_index);
+        }
+
+        MapIterator& operator++()
+        {
+            m_index = m_map->next_full(m_index + 1);
+            return *this;
+        }
+
+        MapIterator operator++(int)
+        {
+            MapIterator iterator { *this };
+            ++(*this);
+            return iterator;
+        }
+
+        friend bool operator==(const MapIterator& a, const MapIterator& other)
+        {
+            return (a.m_index == other.m_index);
+        }
+
+        friend bool operator!=(const MapIterator& a, const MapIterator& other)
+        {
+            return (a.m_index != other.m_index);
+        }
+    };
+
+public:
+    using iterator = MapIterator<false>;
+    using const_iterator = MapIterator<true>;
+
+    FlatHashMap() = default;
+
+    FlatHashMap(std::initializer_list<value_type> other)
+    {
+        insert_range(other.begin(), other.end());
+    }
+
+    FlatHashMap(const FlatHashMap& other)
+    : m_hash { other.m_hash },
+      m_equal { other.m_equal }
+    {
+        insert_range(other.begin(), other.end());
+    }
+
+    FlatHashMap(FlatHashMap&& other) noexcept
+    : m_ctrl { std::move(other.m_ctrl) },
+      m_slots { std::move(other.m_slots) },
+      m_size { std::exchange(other.m_size, 0) },
+      m_growth_left { std::exchange(other.m_growth_left, 0) },
+      m_hash { std::move(other.m_hash) },
+      m_equal { std::move(other.m_equal) }
+    {}
+
+    FlatHashMap& operator=(const FlatHashMap& other)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        clear();
+        insert_range(other.begin(), other.end());
+
+        return *this;
+    }
+
+    FlatHashMap& operator=(FlatHashMap&& other) noexcept
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        clear();
+
+        m_ctrl = std::move(other.m_ctrl);
+        m_slots = std::move(other.m_slots);
+        m_size = std::exchange(other.m_size, 0);
+        m_growth_left = std::exchange(other.m_growth_left, 0);
+        m_hash = std::move(other.m_hash);
+        m_equal = std::move(other.m_equal);
+
+        return *this;
+    }
+
+    ~FlatHashMap()
+    {
+        clear();
+    }
+
+    std::size_t size() const noexcept { return m_size; }
+
+    bool is_empty() const noexcept { return (m_size == 0); }
+
+    std::size_t capacity() const noexcept { return m_ctrl.size(); }
+
+    // It makes sure "element_amount" elements can be held without rehashing
+    void reserve(std::size_t element_amount)
+    {
+        std::size_t new_capacity { capacity_for(element_amount) };
+
+        if (new_capacity > capacity())
+        {
+            rehash(new_capacity);
+        }
+    }
+
+    // It destroys every element but keeps the buffers
+    void clear()
+    {
+        if (m_size > 0)
+        {
+            for (std::size_t i {}; i < capacity(); i++)
+            {
+                if (m_ctrl[i] >= 0)
+                {
+                    slot(i)->~value_type();
+                }
+
+                m_ctrl[i] = empty_ctrl;
+            }
+        }
+        else
+        {
+            for (std::size_t i {}; i < capacity(); i++)
+            {
+                m_ctrl[i] = empty_ctrl;
+            }
+        }
+
+        m_size = 0;
+        m_growth_left = (capacity() > 0) ? max_load(capacity()) : 0;
+    }
+
+    // It constructs V from "args" only if "key" isn't in the map already
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(const K& key, Args&&... args)
+    {
+        auto [index, inserted] { try_emplace_impl(key, std::forward<Args>(args)...) };
+        return { iterator(this, index), inserted };
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+    {
+        auto [index, inserted] { try_emplace_impl(std::move(key), std::forward<Args>(args)...) };
+        return { iterator(this, index), inserted };
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+        return try_emplace(value.first, value.second);
+    }
+
+    std::pair<iterator, bool> insert(std::pair<K, V>&& value)
+    {
+        return try_emplace(std::move(value.first), std::move(value.second));
+    }
+
+    // Bulk insertion, it reserves once for all the new elements when their amount is known
+    template<typename InputIt>
+    void insert_range(InputIt first, InputIt last)
+    {
+        if constexpr (std::forward_iterator<InputIt>)
+        {
+            reserve(m_size + static_cast<std::size_t>(std::distance(first, last)));
+        }
+
+        for (; first != last; ++first)
+        {
+            try_emplace((*first).first, (*first).second);
+        }
+    }
+
+    template<typename Range>
+    void insert_range(Range&& range)
+    {
+        insert_range(std::begin(range), std::end(range));
+    }
+
+    V& operator[](const K& key)
+    {
+        return slot(try_emplace_impl(key).first)->second;
+    }
+
+    V& operator[](K&& key)
+    {
+        return slot(try_emplace_impl(std::move(key)).first)->second;
+    }
+
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    iterator find(const Lookup& key)
+    {
+        const auto& k { to_lookup(key) };
+        return iterator(this, find_index(k, hash_of(k)));
+    }
+
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    const_iterator find(const Lookup& key) const
+    {
+        const auto& k { to_lookup(key) };
+        return const_iterator(this, find_index(k, hash_of(k)));
+    }
+
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    bool contains(const Lookup& key) const
+    {
+        const auto& k { to_lookup(key) };
+        return (find_index(k, hash_of(k)) != capacity());
+    }
+
+    // It works like find() but asserts if the key isn't in the map
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    V& at_checked(const Lookup& key)
+    {
+        const auto& k { to_lookup(key) };
+        std::size_t index { find_index(k, hash_of(k)) };
+
+        BASIC_ASSERT((index != capacity()), "The key isn't in the FlatHashMap.\n");
+
+        return slot(index)->second;
+    }
+
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    std::size_t erase(const Lookup& key)
+    {
+        const auto& k { to_lookup(key) };
+        std::size_t index { find_index(k, hash_of(k)) };
+
+        if (index == capacity())
+        {
+            return 0;
+        }
+
+        erase_index(index);
+
+        return 1;
+    }
+
+    // It returns an iterator to the element after the erased one
+    iterator erase(const_iterator position)
+    {
+        erase_index(position.m_index);
+
+        return iterator(this, next_full(position.m_index + 1));
+    }
+
+    iterator begin() noexcept { return iterator(this, next_full(0)); }
+
+    iterator end() noexcept { return iterator(this, capacity()); }
+
+    const_iterator begin() const noexcept { return const_iterator(this, next_full(0)); }
+
+    const_iterator end() const noexcept { return const_iterator(this, capacity()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+};
+
+} // namespace hdsa end
+
+#endif // FLAT_HASH_MAP_HPP
@@ -0,0 +1,819 @@
+#ifndef FLAT_MAP_HPP
+#define FLAT_MAP_HPP
+
+#include "dyn_array.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <iterator>
+#include <functional>
+#include <algorithm>
+#include <utility>
+#include <initializer_list>
+
+/**
+ * Personal implementation of sorted associative containers over DynArrays, as a replacement for
+ * std::map and std::set when the data is read much more often than it's modified.
+ * FlatMap keeps the keys and the values in two separate DynArrays, so a lookup only walks over keys
+ * and a whole search often fits in a few cache lines. FlatSet is the same without the values.
+ * The searches are branchless binary searches, and insert_range() sorts the new elements and merges
+ * them with the old ones in a single linear pass, instead of shifting the arrays once per element.
+ * Inserting or erasing a single element is O(n), like with any sorted array.
+*/
+
+namespace hdsa
+{
+
+// The index of the first of the "size" elements starting at "first" for which "goes_before" is false,
+// assuming all the ones for which it's true come first. The loop always runs log2(size) times and
+// picks the next half with a conditional move, so there are no branches to mispredict
+template<typename T, typename Predicate>
+std::size_t branchless_partition_point(const T* first, std::size_t size, Predicate goes_before)
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    const T* base { first };
+
+    while (size > 1)
+    {
+        std::size_t half { size / 2 };
+
+        base = goes_before(base[half]) ? (base + half) : base;
+        size -= half;
+    }
+
+    return static_cast<std::size_t>(base - first) + static_cast<std::size_t>(goes_before(*base));
+}
+
+template<typename K, typename V, typename Compare = std::less<K>>
+class FlatMap final
+{
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using key_compare = Compare;
+
+    // The keys and the values aren't stored together, so the elements are accessed through pairs of references
+    using reference = std::pair<const K&, V&>;
+    using const_reference = std::pair<const K&, const V&>;
+
+private:
+    // When Compare is transparent, like std::less<>, lookups can use other types than K without converting them first
+    static constexpr bool is_transparent { requires { typename Compare::is_transparent; } };
+
+    template<typename Lookup>
+    static constexpr bool is_lookup_type { is_transparent || std::is_constructible_v<K, const Lookup&> };
+
+    DynArray<K> m_keys {};
+    DynArray<V> m_values {};
+    [[no_unique_address]] Compare m_compare {};
+
+    // It converts "key" to K only when the lookup can't be heterogeneous
+    template<typename Lookup>
+    static decltype(auto) to_lookup(const Lookup& key)
+    {
+        if constexpr (is_transparent || std::is_same_v<Lookup, K>)
+        {
+            return (key);
+        }
+        else
+        {
+            return K(key);
+        }
+    }
+
+    template<typename Lookup>
+    std::size_t lower_bound_index(const Lookup& key) const
+    {
+        return branchless_partition_point(m_keys.data(), m_keys.size(), [&](const K& k) { return m_compare(k, key); });
+    }
+
+    template<typename Lookup>
+    std::size_t upper_bound_index(const Lookup& key) const
+    {
+        return branchless_partition_point(m_keys.data(), m_keys.size(), [&](const K& k) { return !m_compare(key, k); });
+    }
+
+    // It returns the index of "key", or size() if it's not in the map
+    template<typename Lookup>
+    std::size_t find_index(const Lookup& key) const
+    {
+        std::size_t index { lower_bound_index(key) };
+
+        if ((index < m_keys.size()) && !m_compare(key, m_keys[index]))
+        {
+            return index;
+        }
+
+        return m_keys.size();
+    }
+
+    template<typename Key, typename... Args>
+    std::pair<std::size_t, bool> try_emplace_impl(Key&& key, Args&&... args)
+    {
+        std::size_t index { lower_bound_index(key) };
+
+        if ((index < m_keys.size()) && !m_compare(key, m_keys[index]))
+        {
+            return { index, false };
+        }
+
+        m_keys.emplace(m_keys.cbegin() + static_cast<std::ptrdiff_t>(index), std::forward<Key>(key));
+        m_values.emplace(m_values.cbegin() + static_cast<std::ptrdiff_t>(index), std::forward<Args>(args)...);
+
+        return { index, true };
+    }
+
+    void erase_index(std::size_t index)
+    {
+        m_keys.erase(m_keys.cbegin() + static_cast<std::ptrdiff_t>(index));
+        m_values.erase(m_values.cbegin() + static_cast<std::ptrdiff_t>(index));
+    }
+
+    template<bool IsConst>
+    struct MapIterator final
+    {
+        using difference_type = std::ptrdiff_t;
+
+        using value_type = FlatMap::value_type;
+
+        using reference = std::conditional_t<IsConst, FlatMap::const_reference, FlatMap::reference>;
+
+        // operator-> has to return something that works like a pointer, so the pair of references is
+        // returned inside an object whose own operator-> points to it, which makes it->second work
+        struct ArrowProxy final
+        {
+            reference pair;
+
+            const reference* operator->() const noexcept { return &pair; }
+        };
+
+        using pointer = ArrowProxy;
+
+        // Proxy references can't satisfy the legacy forward iterator requirements
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
+
+    private:
+        using map_pointer = std::conditional_t<IsConst, const FlatMap*, FlatMap*>;
+
+        map_pointer m_map { nullptr };
+        std::size_t m_index {};
+
+        friend class FlatMap;
+
+    public:
+        MapIterator() = default;
+
+        MapIterator(map_pointer map, std::size_t index)
+        : m_map { map },
+          m_index { index } {}
+
+        // Every iterator can be used where a const iterator is expected
+        template<bool OtherConst>
+        requires (IsConst && !OtherConst)
+        MapIterator(const MapIterator<OtherConst>& other)
+        : m_map { other.m_map },
+          m_index { other.m_index } {}
+
+        reference operator*() const
+        {
+            return reference { m_map->m_keys[m_index], m_map->m_values[m_index] };
+        }
+
+        ArrowProxy operator->() const
+        {
+            return ArrowProxy { **this };
+        }
+
+        reference operator[](const difference_type position) const
+        {
+            return *(*this + position);
+        }
+
+        const K& key() const
+        {
+            return m_map->m_keys[m_index];
+        }
+
+        auto& value() const
+        {
+            return m_map->m_values[m_index];
+        }
+
+        MapIterator& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        MapIterator operator++(int)
+        {
+            MapIterator iterator { *this };
+            ++(*this);
+            return iterator;
+        }
+
+        MapIterator& operator--()
+        {
+            --m_index;
+            return *this;
+        }
+
+        MapIterator operator--(int)
+        {
+            MapIterator iterator { *this };
+            --(*this);
+            return iterator;
+        }
+
+        MapIterator& operator+=(const difference_type x)
+        {
+            m_index += static_cast<std::size_t>(x);
+            return *this;
+        }
+
+        MapIterator& operator-=(const difference_type x)
+        {
+            m_index -= static_cast<std::size_t>(x);
+            return *this;
+        }
+
+        MapIterator operator+(const difference_type x) const
+        {
+            return MapIterator { m_map, m_index + static_cast<std::size_t>(x) };
+        }
+
+        MapIterator operator-(const difference_type x) const
+        {
+            return MapIterator { m_map, m_index - static_cast<std::size_t>(x) };
+        }
+
+        friend MapIterator operator+(const difference_type x, const MapIterator& it)
+        {
+            return it + x;
+        }
+
+        difference_type operator-(const MapIterator& other) const
+        {
+            return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index);
+        }
+
+        friend bool operator==(const MapIterator& a, const MapIterator& other)
+        {
+            return (a.m_index == other.m_index);
+        }
+
+        friend auto operator<=>(const MapIterator& a, const MapIterator& other)
+        {
+            return (a.m_index <=> other.m_index);
+        }
+    };
+
+public:
+    using iterator = MapIterator<false>;
+    using const_iterator = MapIterator<true>;
+
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare& compare)
+    : m_compare { compare } {}
+
+    template<typename InputIt>
+    FlatMap(InputIt first, InputIt last, const Compare& compare = Compare {})
+    : m_compare { compare }
+    {
+        insert_range(first, last);
+    }
+
+    FlatMap(std::initializer_list<value_type> other)
+    {
+        insert_range(other.begin(), other.end());
+    }
+
+    std::size_t size() const noexcept { return m_keys.size(); }
+
+    bool is_empty() const noexcept { return m_keys.is_empty(); }
+
+    std::size_t capacity() const noexcept { return m_keys.capacity(); }
+
+    void reserve_memory(std::size_t element_amount)
+    {
+        if (element_amount > m_keys.capacity())
+        {
+            m_keys.reserve_memory(element_amount);
+        }
+
+        if (element_amount > m_values.capacity())
+        {
+            m_values.reserve_memory(element_amount);
+        }
+    }
+
+    void clear()
+    {
+        m_keys.destroy_all();
+        m_values.destroy_all();
+    }
+
+    // Read-only access to the sorted keys, and to the values in the same order
+    const DynArray<K>& keys() const noexcept { return m_keys; }
+
+    const DynArray<V>& values() const noexcept { return m_values; }
+
+    // It constructs V from "args" only if "key" isn't in the map already
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(const K& key, Args&&... args)
+    {
+        auto [index, inserted] { try_emplace_impl(key, std::forward<Args>(args)...) };
+        return { iterator(this, index), inserted };
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+    {
+        auto [index, inserted] { try_emplace_impl(std::move(key), std::forward<Args>(args)...) };
+        return { iterator(this, index), inserted };
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+        return try_emplace(value.first, value.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value)
+    {
+        return try_emplace(std::move(value.first), std::move(value.second));
+    }
+
+    // Bulk insertion. The new elements are sorted on their own and then merged with the old ones into new
+    // buffers, so it's O(n + m log m) instead of O(n * m). When a key is repeated, the element that was
+    // already in the map wins, and otherwise the first one in the range does, like with std::map::insert
+    template<typename InputIt>
+    void insert_range(InputIt first, InputIt last)
+    {
+        DynArray<value_type> batch {};
+
+        if constexpr (std::forward_iterator<InputIt>)
+        {
+            std::size_t amount { static_cast<std::size_t>(std::distance(first, last)) };
+
+            if (amount == 0)
+            {
+                return;
+            }
+
+            batch.reserve_memory(amount);
+        }
+
+        for (; first != last; ++first)
+        {
+            batch.emplace_back((*first).first, (*first).second);
+        }
+
+        if (batch.is_empty())
+        {
+            return;
+        }
+
+        std::stable_sort(batch.begin(), batch.end(), [&](const value_type& a, const value_type& b) { return m_compare(a.first, b.first); });
+
+        std::size_t old_size { m_keys.size() };
+
+        DynArray<K> keys {};
+        DynArray<V> values {};
+
+        keys.reserve_memory(old_size + batch.size());
+        values.reserve_memory(old_size + batch.size());
+
+        std::size_t i {};
+
+        for (value_type& element : batch)
+        {
+            while ((i < old_size) && m_compare(m_keys[i], element.first))
+            {
+                keys.push_back(std::move(m_keys[i]));
+                values.push_back(std::move(m_values[i]));
+                i++;
+            }
+
+            // The key is either in the map already or repeated in the batch
+            bool is_repeated { ((i < old_size) && !m_compare(element.first, m_keys[i])) ||
+                               (!keys.is_empty() && !m_compare(keys.last(), element.first)) };
+
+            if (!is_repeated)
+            {
+                keys.push_back(std::move(element.first));
+                values.push_back(std::move(element.second));
+            }
+        }
+
+        for (; i < old_size; i++)
+        {
+            keys.push_back(std::move(m_keys[i]));
+            values.push_back(std::move(m_values[i]));
+        }
+
+        m_keys = std::move(keys);
+        m_values = std::move(values);
+    }
+
+    template<typename Range>
+    void insert_range(Range&& range)
+    {
+        insert_range(std::begin(range), std::end(range));
+    }
+
+    V& operator[](const K& key)
+    {
+        return m_values[try_emplace_impl(key).first];
+    }
+
+    V& operator[](K&& key)
+    {
+        return m_values[try_emplace_impl(std::move(key)).first];
+    }
+
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    iterator find(const Lookup& key)
+    {
+        return iterator(this, find_index(to_lookup(key)));
+    }
+
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    const_iterator find(const Lookup& key) const
+    {
+        return const_iterator(this, find_index(to_lookup(key)));
+    }
+
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    bool contains(const Lookup& key) const
+    {
+        return (find_index(to_lookup(key)) != m_keys.size());
+    }
+
+    // The first element whose key isn't less than "key"
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    iterator lower_bound(const Lookup& key)
+    {
+        return iterator(this, lower_bound_index(to_lookup(key)));
+    }
+
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    const_iterator lower_bound(const Lookup& key) const
+    {
+        return const_iterator(this, lower_bound_index(to_lookup(key)));
+    }
+
+    // The first element whose key is greater than "key"
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    iterator upper_bound(const Lookup& key)
+    {
+        return iterator(this, upper_bound_index(to_lookup(key)));
+    }
+
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    const_iterator upper_bound(const Lookup& key) const
+    {
+        return const_iterator(this, upper_bound_index(to_lookup(key)));
+    }
+
+    // It works like find() but asserts if the key isn't in the map
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    V& at_checked(const Lookup& key)
+    {
+        std::size_t index { find_index(to_lookup(key)) };
+
+        BASIC_ASSERT((index != m_keys.size()), "The key isn't in the FlatMap.\n");
+
+        return m_values[index];
+    }
+
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    const V& at_checked(const Lookup& key) const
+    {
+        std::size_t index { find_index(to_lookup(key)) };
+
+        BASIC_ASSERT((index != m_keys.size()), "The key isn't in the FlatMap.\n");
+
+        return m_values[index];
+    }
+
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    std::size_t erase(const Lookup& key)
+    {
+        std::size_t index { find_index(to_lookup(key)) };
+
+        if (index == m_keys.size())
+        {
+            return 0;
+        }
+
+        erase_index(index);
+
+        return 1;
+    }
+
+    // It returns an iterator to the element after the erased one
+    iterator erase(const_iterator position)
+    {
+        BASIC_ASSERT((position.m_index < m_keys.size()), "The end() iterator can't be erased.\n");
+
+        erase_index(position.m_index);
+
+        return iterator(this, position.m_index);
+    }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+
+    iterator end() noexcept { return iterator(this, m_keys.size()); }
+
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+    const_iterator end() const noexcept { return const_iterator(this, m_keys.size()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+};
+
+template<typename K, typename Compare = std::less<K>>
+class FlatSet final
+{
+public:
+    using key_type = K;
+    using value_type = K;
+
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using key_compare = Compare;
+
+    // The elements can't be modified in place, since that could break the order
+    using iterator = typename DynArray<K>::const_iterator;
+    using const_iterator = typename DynArray<K>::const_iterator;
+
+private:
+    static constexpr bool is_transparent { requires { typename Compare::is_transparent; } };
+
+    template<typename Lookup>
+    static constexpr bool is_lookup_type { is_transparent || std::is_constructible_v<K, const Lookup&> };
+
+    DynArray<K> m_keys {};
+    [[no_unique_address]] Compare m_compare {};
+
+    template<typename Lookup>
+    static decltype(auto) to_lookup(const Lookup& key)
+    {
+        if constexpr (is_transparent || std::is_same_v<Lookup, K>)
+        {
+            return (key);
+        }
+        else
+        {
+            return K(key);
+        }
+    }
+
+    template<typename Lookup>
+    std::size_t lower_bound_index(const Lookup& key) const
+    {
+        return branchless_partition_point(m_keys.data(), m_keys.size(), [&](const K& k) { return m_compare(k, key); });
+    }
+
+    template<typename Lookup>
+    std::size_t upper_bound_index(const Lookup& key) const
+    {
+        return branchless_partition_point(m_keys.data(), m_keys.size(), [&](const K& k) { return !m_compare(key, k); });
+    }
+
+    template<typename Lookup>
+    std::size_t find_index(const Lookup& key) const
+    {
+        std::size_t index { lower_bound_index(key) };
+
+        if ((index < m_keys.size()) && !m_compare(key, m_keys[index]))
+        {
+            return index;
+        }
+
+        return m_keys.size();
+    }
+
+    const_iterator iterator_at(std::size_t index) const noexcept
+    {
+        return m_keys.cbegin() + static_cast<std::ptrdiff_t>(index);
+    }
+
+    template<typename Key>
+    std::pair<iterator, bool> insert_impl(Key&& key)
+    {
+        std::size_t index { lower_bound_index(key) };
+
+        if ((index < m_keys.size()) && !m_compare(key, m_keys[index]))
+        {
+            return { iterator_at(index), false };
+        }
+
+        m_keys.emplace(iterator_at(index), std::forward<Key>(key));
+
+        return { iterator_at(index), true };
+    }
+
+public:
+    FlatSet() = default;
+
+    explicit FlatSet(const Compare& compare)
+    : m_compare { compare } {}
+
+    template<typename InputIt>
+    FlatSet(InputIt first, InputIt last, const Compare& compare = Compare {})
+    : m_compare { compare }
+    {
+        insert_range(first, last);
+    }
+
+    FlatSet(std::initializer_list<K> other)
+    {
+        insert_range(other.begin(), other.end());
+    }
+
+    std::size_t size() const noexcept { return m_keys.size(); }
+
+    bool is_empty() const noexcept { return m_keys.is_empty(); }
+
+    std::size_t capacity() const noexcept { return m_keys.capacity(); }
+
+    void reserve_memory(std::size_t element_amount)
+    {
+        if (element_amount > m_keys.capacity())
+        {
+            m_keys.reserve_memory(element_amount);
+        }
+    }
+
+    void clear()
+    {
+        m_keys.destroy_all();
+    }
+
+    const K* data() const noexcept { return m_keys.data(); }
+
+    std::pair<iterator, bool> insert(const K& key)
+    {
+        return insert_impl(key);
+    }
+
+    std::pair<iterator, bool> insert(K&& key)
+    {
+        return insert_impl(std::move(key));
+    }
+
+    // Bulk insertion, it sorts the new keys and merges them with the old ones in a single linear pass
+    template<typename InputIt>
+    void insert_range(InputIt first, InputIt last)
+    {
+        DynArray<K> batch {};
+
+        if constexpr (std::forward_iterator<InputIt>)
+        {
+            std::size_t amount { static_cast<std::size_t>(std::distance(first, last)) };
+
+            if (amount == 0)
+            {
+                return;
+            }
+
+            batch.reserve_memory(amount);
+        }
+
+        for (; first != last; ++first)
+        {
+            batch.emplace_back(*first);
+        }
+
+        if (batch.is_empty())
+        {
+            return;
+        }
+
+        std::stable_sort(batch.begin(), batch.end(), m_compare);
+
+        std::size_t old_size { m_keys.size() };
+
+        DynArray<K> keys {};
+        keys.reserve_memory(old_size + batch.size());
+
+        std::size_t i {};
+
+        for (K& key : batch)
+        {
+            while ((i < old_size) && m_compare(m_keys[i], key))
+            {
+                keys.push_back(std::move(m_keys[i]));
+                i++;
+            }
+
+            bool is_repeated { ((i < old_size) && !m_compare(key, m_keys[i])) ||
+                               (!keys.is_empty() && !m_compare(keys.last(), key)) };
+
+            if (!is_repeated)
+            {
+                keys.push_back(std::move(key));
+            }
+        }
+
+        for (; i < old_size; i++)
+        {
+            keys.push_back(std::move(m_keys[i]));
+        }
+
+        m_keys = std::move(keys);
+    }
+
+    template<typename Range>
+    void insert_range(Range&& range)
+    {
+        insert_range(std::begin(range), std::end(range));
+    }
+
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    const_iterator find(const Lookup& key) const
+    {
+        return iterator_at(find_index(to_lookup(key)));
+    }
+
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    bool contains(const Lookup& key) const
+    {
+        return (find_index(to_lookup(key)) != m_keys.size());
+    }
+
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    const_iterator lower_bound(const Lookup& key) const
+    {
+        return iterator_at(lower_bound_index(to_lookup(key)));
+    }
+
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    const_iterator upper_bound(const Lookup& key) const
+    {
+        return iterator_at(upper_bound_index(to_lookup(key)));
+    }
+
+    template<typename Lookup>
+    requires is_lookup_type<Lookup>
+    std::size_t erase(const Lookup& key)
+    {
+        std::size_t index { find_index(to_lookup(key)) };
+
+        if (index == m_keys.size())
+        {
+            return 0;
+        }
+
+        m_keys.erase(iterator_at(index));
+
+        return 1;
+    }
+
+    // It returns an iterator to the element after the erased one
+    const_iterator erase(const_iterator position)
+    {
+        return m_keys.erase(position);
+    }
+
+    const_iterator begin() const noexcept { return m_keys.cbegin(); }
+
+    const_iterator end() const noexcept { return m_keys.cend(); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+};
+
+} // namespace hdsa end
+
+#endif // FLAT_MAP_HPP
@@ -0,0 +1,599 @@
+#ifndef GAP_BUFFER_HPP
+#define GAP_BUFFER_HPP
+
+#include "dyn_array.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <iterator>
+#include <new>
+#include <iostream>
+#include <utility>
+#include <initializer_list>
+
+/**
+ * Personal implementation of a gap buffer, the classic structure behind text editors.
+ * The elements live in a single buffer with a "gap" of free spots at the position of a cursor, so
+ * inserting or erasing at the cursor is O(1): it only makes the gap smaller or bigger. Moving the
+ * cursor moves the gap, which only shifts the elements between the old and the new position, so
+ * edits that are close to each other stay cheap, unlike with DynArray where every insertion shifts
+ * the whole tail.
+ * The gap is moved with memmove for trivially copyable types, and the iterators skip over it, so from
+ * the outside it looks like any other random access container.
+*/
+
+namespace hdsa
+{
+
+template<typename T>
+class GapBuffer final
+{
+public:
+    using value_type = T;
+
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+private:
+    T* m_first_ptr { nullptr };
+    std::size_t m_gap_begin {};     // Also the position of the cursor
+    std::size_t m_gap_end {};
+    std::size_t m_capacity {};
+
+    static constexpr bool is_relocatable_with_memmove { std::is_trivially_copyable_v<T> };
+
+    std::size_t gap_size() const noexcept { return (m_gap_end - m_gap_begin); }
+
+    // The spot in the buffer of the element at "position"
+    std::size_t physical(std::size_t position) const noexcept
+    {
+        return (position < m_gap_begin) ? position : (position + gap_size());
+    }
+
+    // It moves "amount" elements from "source" to "destination", which may overlap
+    static void relocate(T* destination, T* source, std::size_t amount)
+    {
+        // When the gap is empty, moving the cursor doesn't move anything
+        if ((amount == 0) || (destination == source))
+        {
+            return;
+        }
+
+        if constexpr (is_relocatable_with_memmove)
+        {
+            std::memmove(static_cast<void*>(destination), static_cast<const void*>(source), amount * sizeof(T));
+        }
+        else if (destination < source)
+        {
+            for (std::size_t i {}; i < amount; i++)
+            {
+                new (destination + i) T(std::move_if_noexcept(source[i]));
+                source[i].~T();
+            }
+        }
+        else
+        {
+            for (std::size_t i { amount }; i > 0; i--)
+            {
+                new (destination + i - 1) T(std::move_if_noexcept(source[i - 1]));
+                source[i - 1].~T();
+            }
+        }
+    }
+
+    // It moves the elements after the gap into a new buffer of "element_amount" spots, keeping the gap in
+    // the same position
+    void mem_realloc(std::size_t element_amount)
+    {
+        T* new_buffer { static_cast<T*>(::operator new(element_amount * sizeof(T))) };
+        std::size_t after_gap { m_capacity - m_gap_end };
+
+        relocate(new_buffer, m_first_ptr, m_gap_begin);
+        relocate(new_buffer + element_amount - after_gap, m_first_ptr + m_gap_end, after_gap);
+
+        if (m_first_ptr != nullptr)
+        {
+            ::operator delete(m_first_ptr, m_capacity * sizeof(T));
+        }
+
+        m_first_ptr = new_buffer;
+        m_gap_end = element_amount - after_gap;
+        m_capacity = element_amount;
+    }
+
+    void grow_by_2()
+    {
+        BASIC_ASSERT((m_capacity <= (std::numeric_limits<std::size_t>::max() / 2)), "The GapBuffer has reached the limit of std::size_t, so it cannot grow any further.\n");
+
+        mem_realloc((m_capacity == 0) ? 1 : (m_capacity * 2));
+    }
+
+    template<bool IsConst>
+    struct GapIterator final
+    {
+        using difference_type = std::ptrdiff_t;
+
+        using value_type = GapBuffer::value_type;
+
+        using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+
+        using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
+
+    private:
+        using buffer_pointer = std::conditional_t<IsConst, const GapBuffer*, GapBuffer*>;
+
+        buffer_pointer m_buffer { nullptr };
+        std::size_t m_index {};
+
+        friend class GapBuffer;
+
+    public:
+        GapIterator() = default;
+
+        GapIterator(buffer_pointer buffer, std::size_t index)
+        : m_buffer { buffer },
+          m_index { index } {}
+
+        // Every iterator can be used where a const iterator is expected
+        template<bool OtherConst>
+        requires (IsConst && !OtherConst)
+        GapIterator(const GapIterator<OtherConst>& other)
+        : m_buffer { other.m_buffer },
+          m_index { other.m_index } {}
+
+        reference operator*() const
+        {
+            return (*m_buffer)[m_index];
+        }
+
+        pointer operator->() const
+        {
+            return &(*m_buffer)[m_index];
+        }
+
+        reference operator[](const difference_type position) const
+        {
+            return (*m_buffer)[m_index + static_cast<std::size_t>(position)];
+        }
+
+        GapIterator& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        GapIterator operator++(int)
+        {
+            GapIterator iterator { *this };
+            ++(*this);
+            return iterator;
+        }
+
+        GapIterator& operator--()
+        {
+            --m_index;
+            return *this;
+        }
+
+        GapIterator operator--(int)
+        {
+            GapIterator iterator { *this };
+            --(*this);
+            return iterator;
+        }
+
+        GapIterator& operator+=(const difference_type x)
+        {
+            m_index += static_cast<std::size_t>(x);
+            return *this;
+        }
+
+        GapIterator& operator-=(const difference_type x)
+        {
+            m_index -= static_cast<std::size_t>(x);
+            return *this;
+        }
+
+        GapIterator operator+(const difference_type x) const
+        {
+            return GapIterator { m_buffer, m_index + static_cast<std::size_t>(x) };
+        }
+
+        GapIterator operator-(const difference_type x) const
+        {
+            return GapIterator { m_buffer, m_index - static_cast<std::size_t>(x) };
+        }
+
+        friend GapIterator operator+(const difference_type x, const GapIterator& it)
+        {
+            return it + x;
+        }
+
+        difference_type operator-(const GapIterator& other) const
+        {
+            return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index);
+        }
+
+        friend bool operator==(const GapIterator& a, const GapIterator& other)
+        {
+            return (a.m_index == other.m_index);
+        }
+
+        friend auto operator<=>(const GapIterator& a, const GapIterator& other)
+        {
+            return (a.m_index <=> other.m_index);
+        }
+    };
+
+public:
+    using iterator = GapIterator<false>;
+    using const_iterator = GapIterator<true>;
+
+    GapBuffer() = default;
+
+    GapBuffer(std::initializer_list<T> other)
+    {
+        reserve_memory(other.size());
+
+        for (const T& t : other)
+        {
+            push_back(t);
+        }
+    }
+
+    GapBuffer(const GapBuffer& other)
+    {
+        reserve_memory(other.size());
+
+        for (std::size_t i {}; i < other.size(); i++)
+        {
+            push_back(other[i]);
+        }
+    }
+
+    GapBuffer(GapBuffer&& other) noexcept
+    : m_first_ptr { std::exchange(other.m_first_ptr, nullptr) },
+      m_gap_begin { std::exchange(other.m_gap_begin, 0) },
+      m_gap_end { std::exchange(other.m_gap_end, 0) },
+      m_capacity { std::exchange(other.m_capacity, 0) }
+    {}
+
+    GapBuffer& operator=(const GapBuffer& other)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        clear();
+        reserve_memory(other.size());
+
+        for (std::size_t i {}; i < other.size(); i++)
+        {
+            push_back(other[i]);
+        }
+
+        return *this;
+    }
+
+    GapBuffer& operator=(GapBuffer&& other) noexcept
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        reset_array();
+
+        m_first_ptr = std::exchange(other.m_first_ptr, nullptr);
+        m_gap_begin = std::exchange(other.m_gap_begin, 0);
+        m_gap_end = std::exchange(other.m_gap_end, 0);
+        m_capacity = std::exchange(other.m_capacity, 0);
+
+        return *this;
+    }
+
+    ~GapBuffer()
+    {
+        reset_array();
+    }
+
+    std::size_t size() const noexcept { return (m_capacity - gap_size()); }
+
+    std::size_t capacity() const noexcept { return m_capacity; }
+
+    bool is_empty() const noexcept { return (size() == 0); }
+
+    bool is_full() const noexcept { return (m_gap_begin == m_gap_end); }
+
+    // The position where insert_at_cursor() puts the next element
+    std::size_t cursor() const noexcept { return m_gap_begin; }
+
+    T& operator[](std::size_t position)
+    {
+        return m_first_ptr[physical(position)];
+    }
+
+    const T& operator[](std::size_t position) const
+    {
+        return m_first_ptr[physical(position)];
+    }
+
+    // It works the same as operator[] but it has bounds checking
+    T& at_checked(const std::size_t position)
+    {
+        BASIC_ASSERT((position < size()), "The position must be a positive number and not bigger than the size of the GapBuffer.\n");
+
+        return m_first_ptr[physical(position)];
+    }
+
+    const T& at_checked(const std::size_t position) const
+    {
+        BASIC_ASSERT((position < size()), "The position must be a positive number and not bigger than the size of the GapBuffer.\n");
+
+        return m_first_ptr[physical(position)];
+    }
+
+    T& first()
+    {
+        BASIC_ASSERT(!is_empty(), "The GapBuffer is empty, you can't get the first element.\n");
+
+        return (*this)[0];
+    }
+
+    const T& first() const
+    {
+        BASIC_ASSERT(!is_empty(), "The GapBuffer is empty, you can't get the first element.\n");
+
+        return (*this)[0];
+    }
+
+    T& last()
+    {
+        BASIC_ASSERT(!is_empty(), "The GapBuffer is empty, you can't get the last element.\n");
+
+        return (*this)[size() - 1];
+    }
+
+    const T& last() const
+    {
+        BASIC_ASSERT(!is_empty(), "The GapBuffer is empty, you can't get the last element.\n");
+
+        return (*this)[size() - 1];
+    }
+
+    void reserve_memory(std::size_t element_amount)
+    {
+        if (element_amount <= m_capacity)
+        {
+            return;
+        }
+
+        mem_realloc(element_amount);
+    }
+
+    // It moves the gap to "position", shifting only the elements between the old and the new cursor
+    void move_cursor(std::size_t position)
+    {
+        BASIC_ASSERT((position <= size()), "The cursor can't go past the end of the GapBuffer.\n");
+
+        if (position < m_gap_begin)
+        {
+            std::size_t amount { m_gap_begin - position };
+
+            relocate(m_first_ptr + m_gap_end - amount, m_first_ptr + position, amount);
+            m_gap_begin -= amount;
+            m_gap_end -= amount;
+        }
+        else if (position > m_gap_begin)
+        {
+            std::size_t amount { position - m_gap_begin };
+
+            relocate(m_first_ptr + m_gap_begin, m_first_ptr + m_gap_end, amount);
+            m_gap_begin += amount;
+            m_gap_end += amount;
+        }
+    }
+
+    // It constructs the element at the cursor, and the cursor ends up after it
+    template<typename... Args>
+    T& emplace_at_cursor(Args&&... args)
+    {
+        T* spot { nullptr };
+
+        if (is_full())
+        {
+            // "args" can refer to one of the elements, so the new one is built before growing moves them
+            T t(std::forward<Args>(args)...);
+
+            grow_by_2();
+
+            spot = m_first_ptr + m_gap_begin;
+            new (spot) T(std::move(t));
+        }
+        else
+        {
+            spot = m_first_ptr + m_gap_begin;
+            new (spot) T(std::forward<Args>(args)...);
+        }
+
+        m_gap_begin++;
+
+        return *spot;
+    }
+
+    void insert_at_cursor(const T& t)
+    {
+        emplace_at_cursor(t);
+    }
+
+    void insert_at_cursor(T&& t)
+    {
+        emplace_at_cursor(std::move(t));
+    }
+
+    // It erases the element before the cursor, like the backspace key
+    void erase_before_cursor()
+    {
+        if (m_gap_begin == 0)
+        {
+            std::cout << "There are no elements before the cursor, no elements will be erased.\n";
+            return;
+        }
+
+        m_gap_begin--;
+        m_first_ptr[m_gap_begin].~T();
+    }
+
+    // It erases the element after the cursor, like the delete key
+    void erase_after_cursor()
+    {
+        if (m_gap_end == m_capacity)
+        {
+            std::cout << "There are no elements after the cursor, no elements will be erased.\n";
+            return;
+        }
+
+        m_first_ptr[m_gap_end].~T();
+        m_gap_end++;
+    }
+
+    // It moves the cursor to "index" and constructs the element there. "args" can refer to one of the
+    // elements that move_cursor() relocates, so the new element is built first, unless the cursor is
+    // already there and nothing has to move (the common case of typing at the cursor)
+    template<typename... Args>
+    T& emplace_at(std::size_t index, Args&&... args)
+    {
+        if (index == m_gap_begin)
+        {
+            return emplace_at_cursor(std::forward<Args>(args)...);
+        }
+
+        T t(std::forward<Args>(args)...);
+
+        move_cursor(index);
+
+        return emplace_at_cursor(std::move(t));
+    }
+
+    // The same as the DynArray ones, but they move the cursor to "position" first
+    template<typename... Args>
+    iterator emplace(const_iterator position, Args&&... args)
+    {
+        std::size_t index { position.m_index };
+
+        emplace_at(index, std::forward<Args>(args)...);
+
+        return iterator(this, index);
+    }
+
+    iterator insert(const_iterator position, const T& t)
+    {
+        return emplace(position, t);
+    }
+
+    iterator insert(const_iterator position, T&& t)
+    {
+        return emplace(position, std::move(t));
+    }
+
+    iterator erase(const_iterator position)
+    {
+        std::size_t index { position.m_index };
+
+        BASIC_ASSERT((index < size()), "The end() iterator can't be erased.\n");
+
+        move_cursor(index);
+        erase_after_cursor();
+
+        return iterator(this, index);
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        return emplace_at(size(), std::forward<Args>(args)...);
+    }
+
+    void push_back(const T& t)
+    {
+        emplace_back(t);
+    }
+
+    void push_back(T&& t)
+    {
+        emplace_back(std::move(t));
+    }
+
+    void pop_back()
+    {
+        if (is_empty())
+        {
+            std::cout << "The GapBuffer is already empty, no elements will be popped out.\n";
+            return;
+        }
+
+        move_cursor(size());
+        erase_before_cursor();
+    }
+
+    // It destroys all the elements but keeps the buffer
+    void clear()
+    {
+        for (std::size_t i {}; i < m_gap_begin; i++)
+        {
+            m_first_ptr[i].~T();
+        }
+
+        for (std::size_t i { m_gap_end }; i < m_capacity; i++)
+        {
+            m_first_ptr[i].~T();
+        }
+
+        m_gap_begin = 0;
+        m_gap_end = m_capacity;
+    }
+
+    // It destroys all the elements and deallocates the buffer
+    void reset_array()
+    {
+        clear();
+
+        if (m_first_ptr != nullptr)
+        {
+            ::operator delete(m_first_ptr, m_capacity * sizeof(T));
+            m_first_ptr = nullptr;
+        }
+
+        m_gap_begin = 0;
+        m_gap_end = 0;
+        m_capacity = 0;
+    }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+
+    iterator end() noexcept { return iterator(this, size()); }
+
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+    const_iterator end() const noexcept { return const_iterator(this, size()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+};
+
+} // namespace hdsa end
+
+#endif // GAP_BUFFER_HPP
@@ -1,7 +1,36 @@
 #include "dyn_array.hpp"
+#include "soa_dyn_array.hpp"
+#include "mapped_dyn_array.hpp"
+#include "dyn_array_serialization.hpp"
+#include "chunk_stream.hpp"
+#include "bit_array.hpp"
+#include "flat_hash_map.hpp"
+#include "dary_heap.hpp"
+#include "ring_buffer.hpp"
+#include "concurrent_queues.hpp"
+#include "flat_map.hpp"
+#include "slot_map.hpp"
+#include "packed_int_array.hpp"
+#include "gap_buffer.hpp"
+#include "thread_pool.hpp"
+#include "parallel_algorithms.hpp"
+#include "cow_dyn_array.hpp"
+#include "dyn_array_hash.hpp"
+#include "dyn_array_format.hpp"
+#include "dyn_array_parse.hpp"
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <ranges>
+#include <span>
+#include <array>
+#include <utility>
+#include <cstdio>
+#include <sstream>
+#include <thread>
+#include <fcntl.h>
+#include <limits>
+#include <unordered_map>
 
 struct Vec3
 {
@@ -351,6 +380,1189 @@ void const_iterators_tests()
     std::cout << "begin <= copy is: " << (begin <= copy) << "\n\n";
 }
 
+void ranges_tests()
+{
+    static_assert(std::contiguous_iterator<hdsa::DynArray<int>::iterator>);
+    static_assert(std::contiguous_iterator<hdsa::DynArray<int>::const_iterator>);
+    static_assert(std::random_access_iterator<hdsa::DynArray<int>::reverse_iterator>);
+    static_assert(std::ranges::contiguous_range<hdsa::DynArray<int>>);
+    static_assert(std::ranges::contiguous_range<const hdsa::DynArray<int>>);
+    static_assert(std::ranges::sized_range<hdsa::DynArray<int>>);
+
+    hdsa::DynArray<int> d { 5, 3, 9, 1, 7 };
+    hdsa::DynArray<int> copy(d.size());
+
+    std::ranges::sort(d);
+    std::ranges::copy(d, copy.begin());
+
+    std::cout << "std::ranges::sort and std::ranges::copy test: \n";
+    std::cout << "copy is: " << copy << '\n';
+
+    std::span<const int> s { d };
+
+    std::cout << "std::span test: \n";
+    std::cout << "s.size() is: " << s.size() << "\n\n";
+
+    hdsa::DynArray<int> empty {};
+
+    std::cout << "Empty range test: \n";
+    std::cout << "begin == end is: " << (empty.begin() == empty.end()) << "\n\n";
+
+    for (int x : d | std::views::reverse | std::views::take(2))
+    {
+        std::cout << x << ' ';
+    }
+
+    std::cout << "\n\n";
+}
+
+void insert_erase_tests()
+{
+    hdsa::DynArray<Vec3> d { Vec3(4, 6, 8, 2), Vec3{}, Vec3(1, 9, 3, 7) };
+
+    d.insert(d.begin() + 1, Vec3(1, 5, 9, 4));
+    d.emplace(d.end(), 3, 6, 5, 2);
+
+    std::cout << "insert and emplace test: \n";
+    std::cout << "d is: " << d << '\n';
+
+    d.erase(d.begin());
+    d.unordered_erase(d.begin());
+
+    std::cout << "erase and unordered_erase test: \n";
+    std::cout << "d is: " << d << '\n';
+
+    hdsa::DynArray<int> numbers { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    std::size_t calls {};
+    std::size_t removed { hdsa::erase_if(numbers, [&calls](int x) { calls++; return ((x % 2) == 0); }) };
+
+    std::cout << "erase_if test: \n";
+    std::cout << "removed is: " << removed << '\n';
+    std::cout << "numbers is: " << numbers << '\n';
+    std::cout << "the predicate was called " << calls << " times for 10 elements\n";
+
+    hdsa::DynArray<Vec3> vectors { Vec3(4, 6, 8, 2), Vec3{}, Vec3(1, 9, 3, 7) };
+    calls = 0;
+    hdsa::erase_if(vectors, [&calls](const Vec3& v) { calls++; return (v.x == 1); });
+
+    std::cout << "the predicate was called " << calls << " times for 3 elements that aren't trivially copyable\n";
+}
+
+void soa_tests()
+{
+    hdsa::SoADynArray<int, double, Vec3> s {};
+
+    s.push_back({ 1, 1.5, Vec3(4, 6, 8, 2) });
+    s.push_back({ 2, 2.5, Vec3{} });
+    s.emplace_back(3, 3.5, Vec3(1, 9, 3, 7));
+
+    std::cout << "Size and capacity test: \n";
+    std::cout << "size is: " << s.size() << ", capacity is: " << s.capacity() << "\n\n";
+
+    int sum {};
+
+    for (int x : s.field<0>())
+    {
+        sum += x;
+    }
+
+    std::cout << "Single field span test: \n";
+    std::cout << "sum of field 0 is: " << sum << "\n\n";
+
+    std::cout << "Row-wise iteration test: \n";
+
+    for (auto [i, d, v] : s)
+    {
+        d *= 2;
+        std::cout << i << ", " << d << ", " << v << '\n';
+    }
+
+    std::cout << '\n';
+
+    // The new rows copy the fields of the first one while the buffers grow
+    hdsa::SoADynArray<std::string, int> names {};
+    names.emplace_back("a string too long for the small string optimization", 1);
+
+    for (int k {}; k < 4; k++)
+    {
+        names.emplace_back(names.field<0>()[0], names.field<1>()[0]);
+        names.push_back(names[0]);
+    }
+
+    std::cout << "emplace_back from a row of the SoADynArray test: \n";
+    std::cout << "size is: " << names.size() << ", last row is: " << std::get<0>(names[names.size() - 1]) << ", " << std::get<1>(names[names.size() - 1]) << "\n\n";
+}
+
+void mapped_dyn_array_tests()
+{
+    const char* path { "hdsa_mapped_test.bin" };
+
+    {
+        hdsa::MappedDynArray<int> m { path };
+
+        m.push_back(1);
+        m.push_back(2);
+        m.emplace_back(3);
+        m.push_back(4);
+
+        // The MappedDynArray is full, so the mapping moves while the first element is being pushed
+        m.push_back(m.first());
+
+        std::cout << "push_back of its own element on a full MappedDynArray test: \n";
+        std::cout << "size is: " << m.size() << ", last is: " << m.last() << "\n\n";
+    }
+
+    {
+        const hdsa::MappedDynArray<int> m { path, hdsa::MapMode::read_only };
+
+        std::cout << "Read-only reopening test: \n";
+
+        for (int x : m)
+        {
+            std::cout << x << ' ';
+        }
+
+        std::cout << "\n\n";
+    }
+
+    {
+        hdsa::MappedDynArray<int> m { path, hdsa::MapMode::copy_on_write };
+
+        while (!m.is_empty())
+        {
+            m.pop_back();
+        }
+
+        m.shrink_to_size();
+
+        std::cout << "Copy-on-write shrink_to_size on an empty MappedDynArray test: \n";
+        std::cout << "capacity is: " << m.capacity() << ", has_memory is: " << m.has_memory() << '\n';
+
+        m.push_back(7);
+
+        std::cout << "size after push_back is: " << m.size() << "\n\n";
+    }
+
+    {
+        hdsa::MappedDynArray<int> m { path, hdsa::MapMode::read_only };
+
+        std::cout << "The copy-on-write changes never reach the file: \n";
+        std::cout << "size is: " << m.size() << ", std::as_const(m)[4] is: " << std::as_const(m)[4] << "\n\n";
+    }
+
+    std::remove(path);
+}
+
+void serialization_tests()
+{
+    hdsa::DynArray<int> d { 5, 3, 9, 1, 7 };
+    std::stringstream stream {};
+
+    hdsa::save(d, stream);
+
+    hdsa::DynArray<int> loaded {};
+    bool is_loaded { hdsa::load(loaded, stream) };
+
+    std::cout << "std::stringstream save and load test: \n";
+    std::cout << "is_loaded is: " << is_loaded << ", loaded is: " << loaded << '\n';
+
+    // A corrupt header claiming far more elements than the data holds must fail instead of allocating them
+    std::string bytes { stream.str() };
+    hdsa::SerializationHeader header {};
+
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    header.count = std::uint64_t { 1 } << 60;
+    std::memcpy(bytes.data(), &header, sizeof(header));
+
+    std::stringstream corrupt { bytes };
+    is_loaded = hdsa::load(loaded, corrupt);
+
+    std::cout << "Corrupt element count test: \n";
+    std::cout << "is_loaded is: " << is_loaded << "\n\n";
+
+    // A failed load leaves the DynArray as it was
+    std::string flipped { stream.str() };
+    flipped[sizeof(hdsa::SerializationHeader)] ^= 1;
+
+    std::stringstream corrupt_elements { flipped };
+    is_loaded = hdsa::load(loaded, corrupt_elements);
+
+    std::cout << "Checksum mismatch test: \n";
+    std::cout << "is_loaded is: " << is_loaded << ", loaded is: " << loaded << "\n\n";
+
+    int pipe_fds[2] {};
+
+    if (::pipe(pipe_fds) == 0)
+    {
+        hdsa::save(d, pipe_fds[1]);
+        ::close(pipe_fds[1]);
+
+        hdsa::DynArray<int> from_pipe {};
+        is_loaded = hdsa::load(from_pipe, pipe_fds[0]);
+        ::close(pipe_fds[0]);
+
+        std::cout << "File descriptor of unknown size (a pipe) test: \n";
+        std::cout << "is_loaded is: " << is_loaded << ", from_pipe is: " << from_pipe << '\n';
+    }
+
+    // Without a known size the elements are read in blocks, so the corrupt count fails after the first one
+    if (::pipe(pipe_fds) == 0)
+    {
+        hdsa::write_all(pipe_fds[1], bytes.data(), bytes.size());
+        ::close(pipe_fds[1]);
+
+        hdsa::DynArray<int> from_pipe { 1, 2 };
+        is_loaded = hdsa::load(from_pipe, pipe_fds[0]);
+        ::close(pipe_fds[0]);
+
+        std::cout << "Corrupt element count from a pipe test: \n";
+        std::cout << "is_loaded is: " << is_loaded << ", from_pipe is: " << from_pipe << ", capacity is: " << from_pipe.capacity() << "\n\n";
+    }
+}
+
+void chunk_stream_tests()
+{
+    const char* path { "hdsa_chunk_test.txt" };
+    int fd { ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644) };
+
+    {
+        hdsa::ChunkStreamWriter writer { fd, 16, 2 };
+
+        for (int i {}; i < 10; i++)
+        {
+            hdsa::ChunkStreamWriter::buffer_type& buffer { writer.acquire() };
+            std::string line { "line " + std::to_string(i) + '\n' };
+
+            for (char c : line)
+            {
+                buffer.push_back(c);
+            }
+
+            writer.submit();
+        }
+
+        std::cout << "ChunkStreamWriter flush test: \n";
+        std::cout << "flush returns: " << writer.flush() << "\n\n";
+    }
+
+    ::close(fd);
+    fd = ::open(path, O_RDONLY);
+
+    {
+        // Chunks of 16 bytes would split the 7 bytes lines, the delimited mode ends them after the last '\n'
+        hdsa::ChunkStream stream { fd, 16, 2, hdsa::ChunkMode::delimited };
+        std::size_t chunks {};
+        std::size_t lines {};
+
+        while (const hdsa::ChunkStream::buffer_type* chunk { stream.next() })
+        {
+            chunks++;
+            lines += static_cast<std::size_t>(std::ranges::count(*chunk, '\n'));
+        }
+
+        std::cout << "Delimited ChunkStream test: \n";
+        std::cout << "chunks is: " << chunks << ", lines is: " << lines << "\n\n";
+    }
+
+    ::close(fd);
+    std::remove(path);
+}
+
+void bit_array_tests()
+{
+    hdsa::BitArray a { 130 };
+    hdsa::BitArray b { 130 };
+
+    a.set(3);
+    a.set(64);
+    a.set(129);
+    b.set(64);
+    b.set(100);
+
+    std::cout << "popcount and find test: \n";
+    std::cout << "a.popcount() is: " << a.popcount() << ", a.find_first() is: " << a.find_first() << ", a.find_next(3) is: " << a.find_next(3) << "\n\n";
+
+    hdsa::BitArray both { a & b };
+    hdsa::BitArray either { a | b };
+    hdsa::BitArray only_one { a ^ b };
+
+    std::cout << "Bulk operations test: \n";
+    std::cout << "(a & b).popcount() is: " << both.popcount() << ", (a | b).popcount() is: " << either.popcount() << ", (a ^ b).popcount() is: " << only_one.popcount() << '\n';
+    std::cout << "(a ^ b) == (a | b).and_not(a & b) is: " << (only_one == either.and_not(both)) << "\n\n";
+
+    a.resize(65);
+    a.push_back(true);
+
+    std::cout << "resize and push_back test: \n";
+    std::cout << "a.size() is: " << a.size() << ", a.popcount() is: " << a.popcount() << "\n\n";
+}
+
+void flat_hash_map_tests()
+{
+    hdsa::FlatHashMap<int, int> squares {};
+
+    // Enough elements to rehash several times
+    for (int i {}; i < 1000; i++)
+    {
+        squares[i] = i * i;
+    }
+
+    for (int i {}; i < 1000; i += 2)
+    {
+        squares.erase(i);
+    }
+
+    long long sum {};
+
+    for (const auto& [key, value] : squares)
+    {
+        sum += value;
+    }
+
+    std::cout << "Insertion, rehash and erase test: \n";
+    std::cout << "size is: " << squares.size() << ", contains(10) is: " << squares.contains(10) << ", find(11)->second is: " << squares.find(11)->second << '\n';
+    std::cout << "sum of the values is: " << sum << "\n\n";
+
+    hdsa::FlatHashMap<std::string, int> words { { "one", 1 }, { "two", 2 } };
+
+    auto [it, is_inserted] { words.try_emplace("one", 100) };
+
+    std::cout << "try_emplace of an existing key test: \n";
+    std::cout << "is_inserted is: " << is_inserted << ", it->second is: " << it->second << "\n\n";
+
+    // The inserted value refers to an element of the map, and some of the insertions rehash
+    hdsa::FlatHashMap<int, std::string> copies {};
+    copies[0] = "a string too long for the small string optimization";
+
+    for (int i { 1 }; i < 100; i++)
+    {
+        copies.try_emplace(i, copies.find(i - 1)->second);
+    }
+
+    bool are_equal { true };
+
+    for (const auto& [key, value] : copies)
+    {
+        are_equal = are_equal && (value == copies.find(0)->second);
+    }
+
+    std::cout << "try_emplace from an element of the map test: \n";
+    std::cout << "size is: " << copies.size() << ", are_equal is: " << are_equal << "\n\n";
+}
+
+// Moving a Task leaves its id at 0, like a handle that gives away what it owns
+struct Task
+{
+    std::size_t id {};
+    int priority {};
+
+    Task() = default;
+
+    Task(std::size_t ida, int prioritya)
+    : id { ida },
+      priority { prioritya }
+    {}
+
+    Task(const Task& other) = default;
+    Task& operator=(const Task& other) = default;
+
+    Task(Task&& other) noexcept
+    : id { std::exchange(other.id, 0) },
+      priority { other.priority }
+    {}
+
+    Task& operator=(Task&& other) noexcept
+    {
+        id = std::exchange(other.id, 0);
+        priority = other.priority;
+
+        return *this;
+    }
+
+    friend bool operator<(const Task& a, const Task& b) { return (a.priority < b.priority); }
+};
+
+struct TaskId
+{
+    std::size_t operator()(const Task& task) const { return task.id; }
+};
+
+void dary_heap_tests()
+{
+    hdsa::DaryHeap<int> numbers { 5, 3, 9, 1, 7, 8 };
+
+    std::cout << "Heap order test: \n";
+
+    while (!numbers.is_empty())
+    {
+        std::cout << numbers.extract_top() << ' ';
+    }
+
+    std::cout << "\n\n";
+
+    hdsa::DaryHeap<Task, 4, std::less<Task>, TaskId> tasks {};
+
+    for (std::size_t id {}; id < 6; id++)
+    {
+        tasks.push(Task(id, static_cast<int>(id * 10)));
+    }
+
+    tasks.update_key(2, Task(2, 100));
+    tasks.decrease_key(4, Task(4, 90));
+
+    Task top { tasks.extract_top() };
+
+    // The id of the extracted task must be the one that leaves the index map, not the moved-from 0
+    std::cout << "extract_top with an index map test: \n";
+    std::cout << "top.id is: " << top.id << ", contains(2) is: " << tasks.contains(2) << ", contains(0) is: " << tasks.contains(0) << '\n';
+    std::cout << "the next top is: " << tasks.top().id << "\n\n";
+}
+
+void ring_buffer_tests()
+{
+    hdsa::RingBuffer<std::string> ring { "b", "c" };
+
+    ring.push_front("a");
+    ring.push_back("d");
+    ring.pop_front();
+    ring.pop_front();
+    ring.push_back("e");
+    ring.push_back("f");
+
+    std::cout << "Wrap-around test: \n";
+    std::cout << "size is: " << ring.size() << ", capacity is: " << ring.capacity() << ", second span size is: " << ring.as_spans().second.size() << '\n';
+
+    for (const std::string& s : ring)
+    {
+        std::cout << s << ' ';
+    }
+
+    std::cout << "\n\n";
+
+    // The RingBuffer is full, so the element being copied lives in the buffer that's replaced
+    ring.push_back(ring.first());
+
+    std::cout << "push_back of its own element on a full RingBuffer test: \n";
+    std::cout << "last is: " << ring.last() << ", capacity is: " << ring.capacity() << "\n\n";
+
+    hdsa::RingBuffer<std::string> full { "x", "y" };
+    full.push_front(full.last());
+
+    std::cout << "push_front of its own element on a full RingBuffer test: \n";
+
+    for (const std::string& s : full)
+    {
+        std::cout << s << ' ';
+    }
+
+    std::cout << "\n\n";
+}
+
+void concurrent_queue_tests()
+{
+    constexpr int amount { 10000 };
+
+    hdsa::SpscQueue<int> spsc { 64 };
+    long long spsc_sum {};
+
+    std::thread producer { [&spsc]()
+    {
+        for (int i {}; i < amount; i++)
+        {
+            while (!spsc.try_push(i))
+            {
+                std::this_thread::yield();
+            }
+        }
+    } };
+
+    for (int received {}; received < amount;)
+    {
+        int values[16] {};
+        std::size_t popped { spsc.try_pop_n(values, 16) };
+
+        for (std::size_t i {}; i < popped; i++)
+        {
+            spsc_sum += values[i];
+        }
+
+        received += static_cast<int>(popped);
+
+        if (popped == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+
+    std::cout << "SpscQueue test: \n";
+    std::cout << "capacity is: " << spsc.capacity() << ", sum is: " << spsc_sum << "\n\n";
+
+    hdsa::MpmcQueue<int> mpmc { 100 };
+    std::atomic<long long> mpmc_sum {};
+    std::atomic<int> mpmc_received {};
+    hdsa::DynArray<std::thread> threads {};
+
+    for (int p {}; p < 2; p++)
+    {
+        threads.emplace_back([&mpmc, p]()
+        {
+            for (int i { p }; i < amount; i += 2)
+            {
+                while (!mpmc.try_push(i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        threads.emplace_back([&mpmc, &mpmc_sum, &mpmc_received]()
+        {
+            while (mpmc_received.load() < amount)
+            {
+                int value {};
+
+                if (mpmc.try_pop(value))
+                {
+                    mpmc_sum += value;
+                    mpmc_received++;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::cout << "MpmcQueue with 2 producers and 2 consumers test: \n";
+    std::cout << "capacity is: " << mpmc.capacity() << ", sum is: " << mpmc_sum.load() << "\n\n";
+    // Batches: an empty one, a full one, and partial ones when the queue has less room or fewer elements
+    hdsa::MpmcQueue<int> batches { 8 };
+    int to_push[12] { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+    int popped[12] {};
+
+    std::size_t pushed_none { batches.try_push_n(to_push, 0) };
+    std::size_t pushed_some { batches.try_push_n(to_push, 5) };
+    std::size_t pushed_partial { batches.try_push_n(to_push + 5, 7) };
+
+    std::cout << "MpmcQueue try_push_n test: \n";
+    std::cout << "pushed_none is: " << pushed_none << ", pushed_some is: " << pushed_some << ", pushed_partial is: " << pushed_partial << '\n';
+
+    std::size_t popped_none { batches.try_pop_n(popped, 0) };
+    std::size_t popped_some { batches.try_pop_n(popped, 6) };
+    std::size_t popped_partial { batches.try_pop_n(popped + 6, 6) };
+    std::size_t popped_empty { batches.try_pop_n(popped, 4) };
+
+    std::cout << "MpmcQueue try_pop_n test: \n";
+    std::cout << "popped_none is: " << popped_none << ", popped_some is: " << popped_some << ", popped_partial is: " << popped_partial << ", popped_empty is: " << popped_empty << '\n';
+    std::cout << "popped is: ";
+
+    for (std::size_t i {}; i < (popped_some + popped_partial); i++)
+    {
+        std::cout << popped[i] << ' ';
+    }
+
+    std::cout << "\n\n";
+}
+
+void flat_map_tests()
+{
+    hdsa::FlatMap<int, std::string> m { { 5, "five" }, { 1, "one" }, { 3, "three" } };
+
+    m.insert_range(hdsa::DynArray<std::pair<int, std::string>> { { 4, "four" }, { 2, "two" }, { 3, "again" } });
+
+    std::cout << "insert_range test: \n";
+
+    for (auto [key, value] : m)
+    {
+        std::cout << key << ": " << value << '\n';
+    }
+
+    std::cout << '\n';
+
+    m.find(2)->second = "TWO";
+
+    const hdsa::FlatMap<int, std::string>& cm { m };
+
+    std::cout << "operator-> test: \n";
+    std::cout << "m.find(2)->second is: " << cm.find(2)->second << ", m.lower_bound(3)->first is: " << m.lower_bound(3)->first << "\n\n";
+
+    m.erase(m.find(1));
+
+    hdsa::FlatSet<int> s { 9, 2, 7, 2 };
+
+    std::cout << "erase and FlatSet test: \n";
+    std::cout << "m.size() is: " << m.size() << ", s.size() is: " << s.size() << ", *s.begin() is: " << *s.begin() << "\n\n";
+}
+
+void slot_map_tests()
+{
+    hdsa::SlotMap<std::string> names {};
+
+    auto ada { names.insert("Ada") };
+    auto alan { names.insert("Alan") };
+    auto grace { names.emplace("Grace") };
+
+    names.erase(alan);
+
+    std::cout << "Stable handles after erase test: \n";
+    std::cout << "names[grace] is: " << names[grace] << ", contains(alan) is: " << names.contains(alan) << ", get(alan) is null: " << (names.get(alan) == nullptr) << '\n';
+
+    // The freed slot is reused with a new generation, so the old handle stays stale
+    auto edsger { names.insert("Edsger") };
+
+    std::cout << "Slot reuse test: \n";
+    std::cout << "edsger.index == alan.index is: " << (edsger.index == alan.index) << ", contains(alan) is: " << names.contains(alan) << '\n';
+
+    std::cout << "Dense iteration test: \n";
+
+    for (const std::string& name : names)
+    {
+        std::cout << name << ' ';
+    }
+
+    std::cout << "\nnames[ada] is: " << names[ada] << "\n\n";
+}
+
+void packed_int_array_tests()
+{
+    hdsa::PackedIntArray packed { 3 };
+
+    for (std::uint64_t i {}; i < 100; i++)
+    {
+        packed.push_back(i % 8);
+    }
+
+    std::cout << "PackedIntArray test: \n";
+    std::cout << "bit_width is: " << packed.bit_width() << ", packed[13] is: " << packed[13] << ", memory_bytes is: " << packed.memory_bytes() << '\n';
+
+    // A value that doesn't fit in 3 bits widens every element
+    packed.set(50, 1000);
+
+    std::cout << "bit_width after set(50, 1000) is: " << packed.bit_width() << ", packed[13] is: " << packed[13] << ", packed[50] is: " << packed[50] << "\n\n";
+
+    hdsa::DeltaArray timestamps {};
+    std::uint64_t value { 1700000000 };
+
+    for (int i {}; i < 300; i++)
+    {
+        value += static_cast<std::uint64_t>(i % 5);
+        timestamps.push_back(value);
+    }
+
+    std::uint64_t decoded[4] {};
+    timestamps.decode(126, 4, decoded);
+
+    std::cout << "DeltaArray test: \n";
+    std::cout << "block_count is: " << timestamps.block_count() << ", memory_bytes is: " << timestamps.memory_bytes() << " instead of " << (300 * sizeof(std::uint64_t)) << '\n';
+    std::cout << "timestamps[200] is: " << timestamps[200] << ", last is: " << timestamps.last() << '\n';
+    std::cout << "decode(126, 4) is: " << decoded[0] << ' ' << decoded[1] << ' ' << decoded[2] << ' ' << decoded[3] << "\n\n";
+}
+
+void gap_buffer_tests()
+{
+    hdsa::GapBuffer<char> text {};
+
+    for (char c : std::string { "Hello world" })
+    {
+        text.insert_at_cursor(c);
+    }
+
+    text.move_cursor(5);
+    text.insert_at_cursor(',');
+    text.move_cursor(text.size());
+    text.erase_before_cursor();
+    text.insert_at_cursor('D');
+
+    std::cout << "Editing at the cursor test: \n";
+
+    for (char c : text)
+    {
+        std::cout << c;
+    }
+
+    std::cout << "\n\n";
+
+    hdsa::GapBuffer<std::string> words { "zero", "one", "two", "three" };
+
+    // The GapBuffer is full, so the element being copied lives in the buffer that's replaced
+    words.push_back(words[0]);
+
+    // The cursor is at the end, so moving it to the front relocates the element being copied
+    words.insert(words.cbegin(), words[2]);
+
+    std::cout << "Inserting its own elements test: \n";
+
+    for (const std::string& word : words)
+    {
+        std::cout << word << ' ';
+    }
+
+    std::cout << "\n\n";
+}
+
+// Nested fork-join: every call spawns one half and runs the other one itself
+long long parallel_fibonacci(hdsa::ThreadPool& pool, int n)
+{
+    if (n < 15)
+    {
+        return (n < 2) ? n : (parallel_fibonacci(pool, n - 1) + parallel_fibonacci(pool, n - 2));
+    }
+
+    long long a {};
+    hdsa::ThreadPool::TaskGroup group { pool };
+
+    group.spawn([&pool, &a, n] { a = parallel_fibonacci(pool, n - 1); });
+
+    long long b { parallel_fibonacci(pool, n - 2) };
+
+    group.sync();
+
+    return a + b;
+}
+
+void thread_pool_tests()
+{
+    hdsa::ThreadPool pool { 4 };
+    std::atomic<long long> sum {};
+
+    pool.parallel_for(0, 100000, [&sum](std::size_t i) { sum += static_cast<long long>(i); });
+
+    std::cout << "parallel_for test: \n";
+    std::cout << "thread_count is: " << pool.thread_count() << ", sum is: " << sum.load() << "\n\n";
+
+    std::atomic<std::size_t> chunks {};
+
+    pool.parallel_for(0, 1000, [&chunks](std::size_t, std::size_t) { chunks++; }, 100);
+
+    std::cout << "parallel_for with chunks and a grain of 100 test: \n";
+    std::cout << "chunks is: " << chunks.load() << "\n\n";
+
+    std::cout << "Nested TaskGroup test: \n";
+    std::cout << "parallel_fibonacci(25) is: " << parallel_fibonacci(pool, 25) << "\n\n";
+}
+
+void parallel_algorithms_tests()
+{
+    hdsa::ThreadPool pool { 4 };
+
+    // Big enough to be split into several blocks
+    hdsa::DynArray<int> numbers(100000);
+
+    for (std::size_t i {}; i < numbers.size(); i++)
+    {
+        numbers[i] = static_cast<int>(i % 10);
+    }
+
+    hdsa::DynArray<long long> sums(numbers.size());
+    hdsa::DynArray<long long> offsets(numbers.size());
+
+    hdsa::inclusive_scan(numbers, sums, std::plus<> {}, pool);
+    hdsa::exclusive_scan(numbers, offsets, 0LL, std::plus<> {}, pool);
+
+    std::cout << "inclusive_scan and exclusive_scan test: \n";
+    std::cout << "sums.last() is: " << sums.last() << ", offsets.last() is: " << offsets.last() << '\n';
+
+    long long squares { hdsa::transform_reduce(numbers, 0LL, std::plus<> {}, [](int x) { return static_cast<long long>(x) * x; }, pool) };
+
+    std::cout << "transform_reduce test: \n";
+    std::cout << "sum of the squares is: " << squares << '\n';
+
+    hdsa::DynArray<std::size_t> histogram { hdsa::parallel_histogram(numbers, 10, [](int x) { return static_cast<std::size_t>(x); }, pool) };
+
+    std::cout << "parallel_histogram test: \n";
+    std::cout << "histogram[3] is: " << histogram[3] << '\n';
+
+    std::size_t even { hdsa::parallel_partition(numbers, [](int x) { return ((x % 2) == 0); }, pool) };
+
+    std::cout << "parallel_partition test: \n";
+    std::cout << "even is: " << even << ", numbers[even - 1] is: " << numbers[even - 1] << ", numbers[even] is: " << numbers[even] << "\n\n";
+}
+
+// The whole DynArray works during constant evaluation, so lookup tables can be built at compile time
+consteval std::array<int, 16> squares_table()
+{
+    hdsa::DynArray<int> table {};
+
+    for (int i {}; i < 20; i++)
+    {
+        table.push_back(i * i);
+    }
+
+    table.insert(table.cbegin() + 3, 2, -1);
+    table.erase_if([](int x) { return (x < 0); });
+    table.resize(16);
+    table.shrink_to_size();
+
+    hdsa::DynArray<int> copy { table };
+    std::array<int, 16> result {};
+
+    std::ranges::copy(copy, result.begin());
+
+    return result;
+}
+
+constexpr std::size_t total_length()
+{
+    hdsa::DynArray<std::string> words { "constant", "evaluation" };
+
+    words.emplace_back(3, 'x');
+    words.erase(words.cbegin());
+
+    std::size_t total {};
+
+    for (const std::string& word : words)
+    {
+        total += word.size();
+    }
+
+    return total;
+}
+
+void constexpr_tests()
+{
+    constexpr std::array<int, 16> squares { squares_table() };
+
+    constexpr std::size_t length { total_length() };
+
+    static_assert((squares[5] == 25) && (squares[15] == 225));
+    static_assert(length == 13);
+
+    std::cout << "Compile time DynArray test: \n";
+    std::cout << "squares[15] is: " << squares[15] << ", length is: " << length << "\n\n";
+}
+
+struct Particle
+{
+    float x {};
+    float y {};
+};
+
+struct Reading
+{
+    int value {};
+};
+
+// Hot element types can opt out of the checks (and the messages) on their own
+template<> struct hdsa::check_policy_for<Particle> { using type = hdsa::unchecked; };
+template<> struct hdsa::check_policy_for<Reading> { using type = hdsa::hardened; };
+
+void check_policy_tests()
+{
+    static_assert(std::is_same_v<hdsa::DynArray<Particle>::check_policy, hdsa::unchecked>);
+    static_assert(std::is_same_v<hdsa::DynArray<Reading>::check_policy, hdsa::hardened>);
+    static_assert(std::is_same_v<hdsa::DynArray<int>::check_policy, HDSA_CHECK_POLICY>);
+    static_assert(std::is_same_v<hdsa::DynArray<int, hdsa::hardened>::check_policy, hdsa::hardened>);
+    static_assert(!hdsa::SilentDynArray<int>::check_policy::prints_messages);
+
+    std::cout << "Unchecked and hardened DynArrays don't print anything test: \n";
+
+    {
+        hdsa::DynArray<Particle> particles {};
+        hdsa::DynArray<Reading> readings {};
+
+        for (int i {}; i < 10; i++)
+        {
+            particles.emplace_back(static_cast<float>(i), 0.0f);
+            readings.push_back(Reading { i });
+        }
+
+        particles.pop_back();
+
+        std::cout << "particles.size() is: " << particles.size() << ", readings.at_checked(9).value is: " << readings.at_checked(9).value << "\n\n";
+    }
+
+    std::cout << "A single DynArray with its own policy and a SilentDynArray don't print anything test: \n";
+
+    {
+        hdsa::DynArray<int, hdsa::unchecked> unchecked_integers {};
+        hdsa::SilentDynArray<int> silent_integers {};
+
+        for (int i {}; i < 10; i++)
+        {
+            unchecked_integers.push_back(i);
+            silent_integers.push_back(i * 2);
+        }
+
+        std::cout << "unchecked_integers[9] is: " << unchecked_integers[9] << ", silent_integers[9] is: " << silent_integers[9] << "\n\n";
+    }
+
+    // The DynArray is full, so the element being copied lives in the buffer that's replaced
+    hdsa::DynArray<Vec3> vectors { Vec3(4, 6, 8, 2), Vec3(1, 9, 3, 7) };
+    vectors.push_back(vectors[0]);
+    vectors.emplace_back(vectors[1]);
+
+    std::cout << "push_back and emplace_back of its own element on a full DynArray test: \n";
+    std::cout << "vectors is: " << vectors << '\n';
+}
+
+struct Sample
+{
+    double value {};
+};
+
+// A buffer that's filled and drained in bursts gives memory back when it's mostly empty
+template<> struct hdsa::shrink_policy_for<Sample> { using type = hdsa::shrink_with_hysteresis<>; };
+template<> struct hdsa::check_policy_for<Sample> { using type = hdsa::unchecked; };
+
+void shrink_policy_tests()
+{
+    hdsa::DynArray<Sample> samples {};
+
+    for (int i {}; i < 1000; i++)
+    {
+        samples.push_back(Sample { static_cast<double>(i) });
+    }
+
+    std::cout << "Shrink with hysteresis test: \n";
+    std::cout << "capacity after 1000 push_back is: " << samples.capacity() << '\n';
+
+    while (samples.size() > 200)
+    {
+        samples.pop_back();
+    }
+
+    std::cout << "capacity after popping down to 200 is: " << samples.capacity() << '\n';
+
+    samples.erase_if([](const Sample& sample) { return (sample.value >= 20.0); });
+
+    std::cout << "capacity after erase_if down to 20 is: " << samples.capacity() << ", samples[19].value is: " << samples[19].value << '\n';
+
+    // Right after shrinking the DynArray is half full, so pushing and popping at the boundary never reallocates
+    std::size_t capacity { samples.capacity() };
+    std::size_t reallocations {};
+
+    for (int i {}; i < 100; i++)
+    {
+        samples.push_back(Sample {});
+        samples.pop_back();
+
+        if (samples.capacity() != capacity)
+        {
+            reallocations++;
+            capacity = samples.capacity();
+        }
+    }
+
+    std::cout << "reallocations while alternating push_back and pop_back is: " << reallocations << '\n';
+
+    samples.resize(0);
+
+    std::cout << "capacity after resize(0) is: " << samples.capacity() << "\n\n";
+}
+
+void cow_dyn_array_tests()
+{
+    hdsa::CowDynArray<std::string> original { "alpha", "beta", "gamma" };
+    hdsa::CowDynArray<std::string> snapshot { original };
+
+    std::cout << "O(1) copy test: \n";
+    std::cout << "use_count is: " << original.use_count() << ", same buffer is: " << (original.data() == snapshot.data()) << "\n\n";
+
+    // Only the modified copy detaches, the snapshot keeps the old elements
+    original.set(1, "BETA");
+    original.push_back("delta");
+
+    std::cout << "Detach on write test: \n";
+    std::cout << "original[1] is: " << original[1] << ", snapshot[1] is: " << snapshot[1] << '\n';
+    std::cout << "original.size() is: " << original.size() << ", snapshot.size() is: " << snapshot.size() << ", use_count is: " << snapshot.use_count() << "\n\n";
+
+    hdsa::CowDynArray<std::string> other { snapshot };
+    other.clear();
+
+    std::cout << "clear of a shared CowDynArray test: \n";
+    std::cout << "other.size() is: " << other.size() << ", snapshot.size() is: " << snapshot.size() << "\n\n";
+
+    hdsa::DynArray<std::string>& unique { snapshot.make_unique() };
+    std::ranges::sort(unique, std::greater<> {});
+
+    std::cout << "make_unique test: \n";
+
+    for (const std::string& s : snapshot)
+    {
+        std::cout << s << ' ';
+    }
+
+    std::cout << "\n\n";
+}
+
+void comparison_tests()
+{
+    hdsa::DynArray<int> a { 1, 2, 3 };
+    hdsa::DynArray<int> b { a };
+    hdsa::DynArray<int> c { 1, 2, 4 };
+    hdsa::DynArray<int> d { 1, 2 };
+
+    std::cout << "operator== test: \n";
+    std::cout << "a == b is: " << (a == b) << ", a == c is: " << (a == c) << ", a == d is: " << (a == d) << ", a == a is: " << (a == a) << '\n';
+    std::cout << "a.same_storage(b) is: " << a.same_storage(b) << ", a.same_storage(a) is: " << a.same_storage(a) << "\n\n";
+
+    std::cout << "operator<=> test: \n";
+    std::cout << "a < c is: " << (a < c) << ", d < a is: " << (d < a) << ", a >= b is: " << (a >= b) << "\n\n";
+
+    // A NaN isn't equal to itself, so neither is a DynArray holding one, whether it's compared with itself or a copy
+    hdsa::DynArray<double> n { 1.0, std::numeric_limits<double>::quiet_NaN() };
+    hdsa::DynArray<double> n_copy { n };
+    hdsa::DynArray<double> zeros { 0.0, -0.0 };
+    hdsa::DynArray<double> negative_zeros { -0.0, 0.0 };
+
+    std::cout << "NaN comparison test: \n";
+    std::cout << "n == n is: " << (n == n) << ", n == n_copy is: " << (n == n_copy) << '\n';
+    std::cout << "zeros == negative_zeros is: " << (zeros == negative_zeros) << "\n\n";
+}
+
+void hash_tests()
+{
+    hdsa::DynArray<int> a { 1, 2, 3 };
+    hdsa::DynArray<int> b { 1, 2, 3 };
+    hdsa::DynArray<int> c { 3, 2, 1 };
+    std::hash<hdsa::DynArray<int>> hasher {};
+
+    std::cout << "std::hash test: \n";
+    std::cout << "hash(a) == hash(b) is: " << (hasher(a) == hasher(b)) << ", hash(a) == hash(c) is: " << (hasher(a) == hasher(c)) << "\n\n";
+
+    // 0.0 == -0.0, so doubles are hashed element by element instead of by their bytes
+    hdsa::DynArray<double> zeros { 0.0, 0.0 };
+    hdsa::DynArray<double> negative_zeros { -0.0, -0.0 };
+
+    std::cout << "Floating point hash test: \n";
+    std::cout << "zeros == negative_zeros is: " << (zeros == negative_zeros) << ", same hash is: " << (hdsa::hash_elements(zeros) == hdsa::hash_elements(negative_zeros)) << "\n\n";
+
+    std::string text { "A longer input, so hash_bytes goes through its 48 bytes loop a few times." };
+    std::uint64_t text_hash { hdsa::hash_bytes(text.data(), text.size()) };
+    text[40] ^= 1;
+
+    std::cout << "hash_bytes test: \n";
+    std::cout << "one flipped bit changes the hash: " << (hdsa::hash_bytes(text.data(), text.size()) != text_hash) << ", the seed changes the hash: " << (hdsa::hash_bytes(text.data(), text.size(), 1) != hdsa::hash_bytes(text.data(), text.size())) << "\n\n";
+
+    std::unordered_map<hdsa::DynArray<int>, std::string> names {};
+    names[a] = "ascending";
+    names[c] = "descending";
+
+    hdsa::FlatHashMap<hdsa::DynArray<int>, int> sums {};
+    sums[a] = 6;
+
+    std::cout << "DynArray key test: \n";
+    std::cout << "names[b] is: " << names[b] << ", names.size() is: " << names.size() << ", sums.contains(b) is: " << sums.contains(b) << ", sums.contains(c) is: " << sums.contains(c) << "\n\n";
+}
+
+void number_dumper_tests()
+{
+    hdsa::DynArray<int> integers { -3, 0, 42, 1000000 };
+    hdsa::DynArray<double> doubles { 0.1, 1.0 / 3.0, -2.5, 1e300 };
+    std::ostringstream out {};
+
+    hdsa::dump_numbers(out, integers);
+    out << '\n';
+    hdsa::dump_numbers(out, doubles, " | ");
+
+    std::cout << "dump_numbers test: \n";
+    std::cout << out.str() << "\n\n";
+
+    // The smallest buffer flushes many times, the output must be the same as with the default one
+    hdsa::DynArray<long long> many {};
+    many.reserve_memory(1000);
+
+    for (long long i {}; i < 1000; i++)
+    {
+        many.push_back(i * 1234567);
+    }
+
+    std::ostringstream small_out {};
+    std::ostringstream big_out {};
+
+    hdsa::NumberDumper small_dumper { 1 };
+    small_dumper.write(small_out, many, "; ");
+    hdsa::dump_numbers(big_out, many, "; ");
+
+    std::cout << "NumberDumper buffer size test: \n";
+    std::cout << "same output is: " << (small_out.str() == big_out.str()) << ", length is: " << small_out.str().size() << "\n\n";
+
+    // Shortest round trip, so reading the text back gives the same doubles
+    std::istringstream in { out.str().substr(out.str().find('\n') + 1) };
+    bool round_trips { true };
+
+    for (std::size_t i {}; i < doubles.size(); i++)
+    {
+        double value {};
+        in >> value;
+        in.ignore(3);
+        round_trips = round_trips && (value == doubles[i]);
+    }
+
+    std::cout << "Round trip test: \n";
+    std::cout << "round_trips is: " << round_trips << "\n\n";
+
+    hdsa::DynArray<int> empty {};
+
+    std::cout << "operator<< test: \n";
+    std::cout << "integers is: " << integers << ", empty is: " << empty << "\n\n";
+
+#if defined(__cpp_lib_format_ranges)
+    std::cout << "std::format test: \n";
+    std::cout << std::format("{}, {:n}, {::#x}, {}", integers, integers, integers, empty) << "\n\n";
+#endif
+}
+
+void parse_tests()
+{
+    hdsa::DynArray<int> integers {};
+    bool is_parsed { hdsa::parse_into(integers, std::string_view { "1, 2,3\n 4 ,,-5\r\n\n6" }) };
+
+    std::cout << "CSV parse test: \n";
+    std::cout << "is_parsed is: " << is_parsed << ", integers is: " << integers << '\n';
+
+    hdsa::DynArray<double> doubles {};
+    is_parsed = hdsa::parse_into(doubles, std::string_view { "0.5\t-1e3\t2.25\n7\t8" }, '\t');
+
+    std::cout << "Tab delimiter test: \n";
+    std::cout << "is_parsed is: " << is_parsed << ", doubles is: " << doubles << '\n';
+
+    // The numbers before the invalid text are kept
+    hdsa::DynArray<int> partial { 100 };
+    is_parsed = hdsa::parse_into(partial, std::string_view { "7,8,nine,10" });
+
+    std::cout << "Invalid text test: \n";
+    std::cout << "is_parsed is: " << is_parsed << ", partial is: " << partial << '\n';
+
+    // A small chunk size splits numbers between chunks
+    std::string text {};
+
+    for (int i {}; i < 200; i++)
+    {
+        text += std::to_string(i * 1001) + ((i % 10 == 9) ? "\n" : ",");
+    }
+
+    int pipe_fds[2] {};
+
+    if (::pipe(pipe_fds) == 0)
+    {
+        bool is_written { ::write(pipe_fds[1], text.data(), text.size()) == static_cast<ssize_t>(text.size()) };
+        ::close(pipe_fds[1]);
+
+        hdsa::DynArray<long> from_pipe {};
+        is_parsed = is_written && hdsa::parse_into(from_pipe, pipe_fds[0], ',', 64);
+        ::close(pipe_fds[0]);
+
+        bool is_correct { from_pipe.size() == 200 };
+
+        for (std::size_t i {}; is_correct && (i < from_pipe.size()); i++)
+        {
+            is_correct = (from_pipe[i] == static_cast<long>(i) * 1001);
+        }
+
+        std::cout << "File descriptor in chunks test: \n";
+        std::cout << "is_parsed is: " << is_parsed << ", from_pipe.size() is: " << from_pipe.size() << ", is_correct is: " << is_correct << "\n\n";
+    }
+}
+
 int main()
 {
     /**
@@ -379,6 +1591,31 @@ int main()
     */
 
     // const_iterators_tests();
+    // ranges_tests();
+    // insert_erase_tests();
+    // soa_tests();
+    // mapped_dyn_array_tests();
+    // serialization_tests();
+    // chunk_stream_tests();
+    // bit_array_tests();
+    // flat_hash_map_tests();
+    // dary_heap_tests();
+    // ring_buffer_tests();
+    // concurrent_queue_tests();
+    // flat_map_tests();
+    // slot_map_tests();
+    // packed_int_array_tests();
+    // gap_buffer_tests();
+    // thread_pool_tests();
+    // parallel_algorithms_tests();
+    // constexpr_tests();
+    // check_policy_tests();
+    // shrink_policy_tests();
+    // cow_dyn_array_tests();
+    // comparison_tests();
+    // hash_tests();
+    // number_dumper_tests();
+    // parse_tests();
 
     hdsa::DynArray<Vec3> v1 { Vec3(6, 4, 5, 2) };
     hdsa::DynArray<Vec3> v2 { v1 };
@@ -0,0 +1,527 @@
+#ifndef MAPPED_DYN_ARRAY_HPP
+#define MAPPED_DYN_ARRAY_HPP
+
+#include "dyn_array.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <cerrno>
+#include <limits>
+#include <type_traits>
+#include <new>
+#include <iostream>
+#include <utility>
+
+/**
+ * Personal implementation of a Dynamic Array whose buffer is a memory-mapped file, for datasets
+ * bigger than RAM or that shouldn't be read entirely at startup. The file only holds the raw
+ * elements, so its size is always size() * sizeof(T) once the MappedDynArray is closed.
+ * It grows with ftruncate + mremap using the same growth policy as DynArray, and only works with
+ * trivially copyable types because the elements are stored as-is in the file.
+ * It needs a POSIX system (mremap is only used on Linux, other systems remap the whole file).
+*/
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hdsa
+{
+
+enum class MapMode
+{
+    read_write,     // Changes are written back to the file, which can grow and shrink
+    read_only,      // Any member function that modifies the elements will assert
+    copy_on_write   // Changes are private to the process and never reach the file
+};
+
+template<typename T>
+class MappedDynArray final
+{
+    static_assert(std::is_trivially_copyable_v<T>, "MappedDynArray only works with trivially copyable types.");
+
+public:
+    using value_type = T;
+    using element_type = value_type;
+
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    // The buffer is always contiguous and the elements are trivially copyable, so raw pointers are enough
+    using iterator = pointer;
+    using const_iterator = const_pointer;
+
+private:
+    T* m_first_ptr { nullptr };
+    std::size_t m_size {};
+    std::size_t m_capacity {};
+    int m_fd { -1 };
+    MapMode m_mode { MapMode::read_write };
+    bool m_file_backed { false };
+
+    void assert_writable() const
+    {
+        BASIC_ASSERT((m_mode != MapMode::read_only), "The MappedDynArray was opened as read-only, its elements cannot be modified.\n");
+    }
+
+    T* map_file(std::size_t element_amount)
+    {
+        int protection { (m_mode == MapMode::read_only) ? PROT_READ : (PROT_READ | PROT_WRITE) };
+        int flags { (m_mode == MapMode::read_write) ? MAP_SHARED : MAP_PRIVATE };
+
+        void* address { ::mmap(nullptr, element_amount * sizeof(T), protection, flags, m_fd, 0) };
+
+        BASIC_ASSERT((address != MAP_FAILED), "mmap failed, the file couldn't be mapped into memory.\n");
+
+        return static_cast<T*>(address);
+    }
+
+    // Used for copy-on-write mappings that need to grow, the private copy can't stay backed by the file
+    // because the pages past its end would give SIGBUS
+    void move_to_anonymous(std::size_t element_amount)
+    {
+        void* address { ::mmap(nullptr, element_amount * sizeof(T), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) };
+
+        BASIC_ASSERT((address != MAP_FAILED), "mmap failed, no anonymous memory could be mapped.\n");
+
+        if (m_first_ptr != nullptr)
+        {
+            std::memcpy(address, m_first_ptr, ((m_size < element_amount) ? m_size : element_amount) * sizeof(T));
+            ::munmap(m_first_ptr, m_capacity * sizeof(T));
+        }
+
+        m_first_ptr = static_cast<T*>(address);
+        m_file_backed = false;
+    }
+
+    void remap(std::size_t element_amount)
+    {
+        if (m_first_ptr == nullptr)
+        {
+            m_first_ptr = map_file(element_amount);
+            return;
+        }
+
+#if defined(__linux__)
+        void* address { ::mremap(m_first_ptr, m_capacity * sizeof(T), element_amount * sizeof(T), MREMAP_MAYMOVE) };
+
+        BASIC_ASSERT((address != MAP_FAILED), "mremap failed, the file couldn't be remapped.\n");
+
+        m_first_ptr = static_cast<T*>(address);
+#else
+        ::munmap(m_first_ptr, m_capacity * sizeof(T));
+        m_first_ptr = map_file(element_amount);
+#endif
+    }
+
+    // It changes the size of the file and the mapping so they can hold "element_amount" elements
+    void mem_realloc(std::size_t element_amount)
+    {
+        assert_writable();
+
+        if (element_amount == m_capacity)
+        {
+            return;
+        }
+
+        // mmap can't map 0 bytes, so an empty MappedDynArray has no mapping at all in every mode
+        if (element_amount == 0)
+        {
+            ::munmap(m_first_ptr, m_capacity * sizeof(T));
+            m_first_ptr = nullptr;
+
+            if (m_file_backed && (m_mode == MapMode::read_write))
+            {
+                int result { ::ftruncate(m_fd, 0) };
+
+                BASIC_ASSERT((result == 0), "ftruncate failed, the file couldn't be resized.\n");
+            }
+        }
+        else if ((!m_file_backed) || (m_mode == MapMode::copy_on_write))
+        {
+            move_to_anonymous(element_amount);
+        }
+        // The file has to grow before the mapping, and shrink after it, so no mapped page is ever past its end
+        else if (element_amount > m_capacity)
+        {
+            int result { ::ftruncate(m_fd, static_cast<off_t>(element_amount * sizeof(T))) };
+
+            BASIC_ASSERT((result == 0), "ftruncate failed, the file couldn't be resized.\n");
+
+            remap(element_amount);
+        }
+        else
+        {
+            remap(element_amount);
+
+            int result { ::ftruncate(m_fd, static_cast<off_t>(element_amount * sizeof(T))) };
+
+            BASIC_ASSERT((result == 0), "ftruncate failed, the file couldn't be resized.\n");
+        }
+
+        m_capacity = element_amount;
+
+        if (m_size > m_capacity)
+        {
+            m_size = m_capacity;
+        }
+    }
+
+    // Same growth policy as DynArray
+    void grow_by_2()
+    {
+        if (m_capacity == 0)
+        {
+            mem_realloc(1);
+            return;
+        }
+
+        mem_realloc(m_capacity * 2);
+    }
+
+public:
+    MappedDynArray() = default;
+
+    // It maps the file at "path", creating it if it doesn't exist and the mode is MapMode::read_write.
+    // Check is_open() afterwards to know if it worked
+    explicit MappedDynArray(const char* path, MapMode mode = MapMode::read_write)
+    {
+        open(path, mode);
+    }
+
+    MappedDynArray(const MappedDynArray& other) = delete;
+    MappedDynArray& operator=(const MappedDynArray& other) = delete;
+
+    MappedDynArray(MappedDynArray&& other) noexcept
+    : m_first_ptr { std::exchange(other.m_first_ptr, nullptr) },
+      m_size { std::exchange(other.m_size, 0) },
+      m_capacity { std::exchange(other.m_capacity, 0) },
+      m_fd { std::exchange(other.m_fd, -1) },
+      m_mode { other.m_mode },
+      m_file_backed { std::exchange(other.m_file_backed, false) }
+    {}
+
+    MappedDynArray& operator=(MappedDynArray&& other) noexcept
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        close();
+
+        m_first_ptr = std::exchange(other.m_first_ptr, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_capacity = std::exchange(other.m_capacity, 0);
+        m_fd = std::exchange(other.m_fd, -1);
+        m_mode = other.m_mode;
+        m_file_backed = std::exchange(other.m_file_backed, false);
+
+        return *this;
+    }
+
+    ~MappedDynArray()
+    {
+        close();
+    }
+
+    // The number of elements is the size of the file divided by sizeof(T), any trailing bytes are ignored
+    bool open(const char* path, MapMode mode = MapMode::read_write)
+    {
+        close();
+
+        int flags { (mode == MapMode::read_write) ? (O_RDWR | O_CREAT) : O_RDONLY };
+
+        m_fd = ::open(path, flags, 0644);
+
+        if (m_fd == -1)
+        {
+            std::cerr << "The file " << path << " couldn't be opened: " << std::strerror(errno) << '\n';
+            return false;
+        }
+
+        struct stat file_info {};
+
+        if (::fstat(m_fd, &file_info) == -1)
+        {
+            std::cerr << "The size of the file " << path << " couldn't be read: " << std::strerror(errno) << '\n';
+            ::close(m_fd);
+            m_fd = -1;
+            return false;
+        }
+
+        m_mode = mode;
+        m_file_backed = true;
+        m_size = static_cast<std::size_t>(file_info.st_size) / sizeof(T);
+        m_capacity = m_size;
+
+        if (m_capacity > 0)
+        {
+            m_first_ptr = map_file(m_capacity);
+        }
+
+        return true;
+    }
+
+    // It unmaps the buffer and closes the file. In MapMode::read_write the spare capacity is cut
+    // from the file, so it ends up holding exactly size() elements
+    void close()
+    {
+        if (m_first_ptr != nullptr)
+        {
+            ::munmap(m_first_ptr, m_capacity * sizeof(T));
+            m_first_ptr = nullptr;
+        }
+
+        if (m_fd != -1)
+        {
+            if ((m_mode == MapMode::read_write) && (m_size != m_capacity))
+            {
+                int result { ::ftruncate(m_fd, static_cast<off_t>(m_size * sizeof(T))) };
+
+                BASIC_ASSERT((result == 0), "ftruncate failed, the file couldn't be resized.\n");
+            }
+
+            ::close(m_fd);
+            m_fd = -1;
+        }
+
+        m_size = 0;
+        m_capacity = 0;
+        m_file_backed = false;
+    }
+
+    // It writes the modified pages back to the file. With "wait" as false it only schedules the writes
+    bool sync(bool wait = true)
+    {
+        if ((m_mode != MapMode::read_write) || (m_first_ptr == nullptr) || (m_size == 0))
+        {
+            return true;
+        }
+
+        return (::msync(m_first_ptr, m_size * sizeof(T), wait ? MS_SYNC : MS_ASYNC) == 0);
+    }
+
+    bool is_open() const noexcept { return (m_fd != -1); }
+
+    MapMode mode() const noexcept { return m_mode; }
+
+    bool is_empty() const noexcept { return (m_size == 0); }
+
+    bool is_full() const noexcept { return ((!is_empty()) && (m_size == m_capacity)); }
+
+    bool has_memory() const noexcept { return (m_first_ptr != nullptr); }
+
+    std::size_t size() const noexcept { return m_size; }
+
+    std::size_t capacity() const noexcept { return m_capacity; }
+
+    // The non-const access functions give writable references, so they assert in MapMode::read_only,
+    // where writing through them would crash because the pages are PROT_READ. Use std::as_const there
+    T* array_ptr() const
+    {
+        assert_writable();
+
+        return m_first_ptr;
+    }
+
+    T* data()
+    {
+        assert_writable();
+
+        return m_first_ptr;
+    }
+
+    const T* data() const noexcept { return m_first_ptr; }
+
+    T& operator[](std::size_t position)
+    {
+        assert_writable();
+
+        return m_first_ptr[position];
+    }
+
+    const T& operator[](std::size_t position) const
+    {
+        return m_first_ptr[position];
+    }
+
+    // It works the same as operator[] but it has bounds checking
+    T& at_checked(const std::size_t position)
+    {
+        assert_writable();
+        BASIC_ASSERT((position < m_size), "The position must be a positive number and not bigger than the size of the MappedDynArray.\n");
+
+        return m_first_ptr[position];
+    }
+
+    const T& at_checked(const std::size_t position) const
+    {
+        BASIC_ASSERT((position < m_size), "The position must be a positive number and not bigger than the size of the MappedDynArray.\n");
+
+        return m_first_ptr[position];
+    }
+
+    T& first()
+    {
+        assert_writable();
+        BASIC_ASSERT(!is_empty(), "The MappedDynArray is empty, you can't get the first element.\n");
+
+        return m_first_ptr[0];
+    }
+
+    const T& first() const
+    {
+        BASIC_ASSERT(!is_empty(), "The MappedDynArray is empty, you can't get the first element.\n");
+
+        return m_first_ptr[0];
+    }
+
+    T& last()
+    {
+        assert_writable();
+        BASIC_ASSERT(!is_empty(), "The MappedDynArray is empty, you can't get the last element.\n");
+
+        return m_first_ptr[m_size - 1];
+    }
+
+    const T& last() const
+    {
+        BASIC_ASSERT(!is_empty(), "The MappedDynArray is empty, you can't get the last element.\n");
+
+        return m_first_ptr[m_size - 1];
+    }
+
+    // Increases the file, the mapping and the capacity
+    void reserve_memory(std::size_t element_amount)
+    {
+        if (element_amount <= m_capacity)
+        {
+            return;
+        }
+
+        mem_realloc(element_amount);
+    }
+
+    void push_back(const T& t)
+    {
+        assert_writable();
+
+        if (m_size == m_capacity)
+        {
+            // "t" can be one of the elements, which mremap can move
+            T copy { t };
+
+            grow_by_2();
+            new (m_first_ptr + m_size) T(copy);
+        }
+        else
+        {
+            new (m_first_ptr + m_size) T(t);
+        }
+
+        m_size++;
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        assert_writable();
+
+        if (m_size == m_capacity)
+        {
+            T element(std::forward<Args>(args)...);
+
+            grow_by_2();
+            new (m_first_ptr + m_size) T(element);
+        }
+        else
+        {
+            new (m_first_ptr + m_size) T(std::forward<Args>(args)...);
+        }
+
+        m_size++;
+
+        return m_first_ptr[m_size - 1];
+    }
+
+    // Trivially copyable types are trivially destructible too, so nothing has to be destroyed
+    void pop_back()
+    {
+        assert_writable();
+
+        if (is_empty())
+        {
+            std::cout << "The MappedDynArray is already empty, no elements will be popped out.\n";
+            return;
+        }
+
+        m_size--;
+    }
+
+    // Changes the size of the MappedDynArray and creates value-initialized T objects in the new spots
+    void resize(std::size_t element_amount)
+    {
+        resize(element_amount, T {});
+    }
+
+    void resize(std::size_t element_amount, const T& value)
+    {
+        assert_writable();
+
+        if (m_capacity < element_amount)
+        {
+            mem_realloc(element_amount);
+        }
+
+        for (std::size_t i { m_size }; i < element_amount; i++)
+        {
+            new (m_first_ptr + i) T(value);
+        }
+
+        m_size = element_amount;
+    }
+
+    // Makes the file and the mapping just big enough to fit all the existing elements
+    void shrink_to_size()
+    {
+        mem_realloc(m_size);
+    }
+
+    iterator begin()
+    {
+        assert_writable();
+
+        return m_first_ptr;
+    }
+
+    iterator end()
+    {
+        assert_writable();
+
+        return m_first_ptr + m_size;
+    }
+
+    const_iterator begin() const noexcept { return m_first_ptr; }
+
+    const_iterator end() const noexcept { return m_first_ptr + m_size; }
+
+    const_iterator cbegin() const noexcept { return m_first_ptr; }
+
+    const_iterator cend() const noexcept { return m_first_ptr + m_size; }
+};
+
+} // namespace hdsa end
+
+#endif // defined(__unix__) || defined(__APPLE__)
+
+#endif // MAPPED_DYN_ARRAY_HPP
@@ -0,0 +1,674 @@
+#ifndef PACKED_INT_ARRAY_HPP
+#define PACKED_INT_ARRAY_HPP
+
+#include "dyn_array.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <bit>
+#include <array>
+#include <iterator>
+#include <iostream>
+#include <utility>
+
+/**
+ * Personal implementation of two compressed arrays of unsigned integers, for big amounts of small
+ * values (IDs, counters, timestamps) that would waste most of the bits of a DynArray<std::uint64_t>.
+ * PackedIntArray stores every element with the same amount of bits, one after another over 64 bits
+ * words. The width is chosen at construction and grows on its own when a bigger value comes in.
+ * DeltaArray is for sorted sequences. The elements are split into blocks of 128, and every block only
+ * stores its first value plus the distance of every element to it ("frame of reference"), packed with
+ * the smallest width that fits the biggest distance. The newest elements wait uncompressed until they
+ * fill a whole block.
+ * Both have O(1) random access, and decode() unpacks whole ranges at once for sequential scans.
+*/
+
+namespace hdsa
+{
+
+namespace bit_packing
+{
+
+inline constexpr std::size_t bits_per_word { 64 };
+
+inline constexpr std::uint64_t mask_of(unsigned bit_width) noexcept
+{
+    return (bit_width == bits_per_word) ? ~std::uint64_t {} : ((std::uint64_t { 1 } << bit_width) - 1);
+}
+
+// The smallest width that can hold "value", a value of 0 still takes 1 bit
+inline constexpr unsigned width_of(std::uint64_t value) noexcept
+{
+    return (value == 0) ? 1u : static_cast<unsigned>(std::bit_width(value));
+}
+
+// The words after the last element must have one more word, so a value that ends in the last word can be
+// read without checking if it crosses into the next one
+inline std::uint64_t read(const std::uint64_t* words, std::size_t bit_position, unsigned bit_width) noexcept
+{
+    std::size_t word { bit_position / bits_per_word };
+    unsigned offset { static_cast<unsigned>(bit_position % bits_per_word) };
+
+    std::uint64_t low { words[word] >> offset };
+    // Shifting by 64 is undefined, so the shift is split in two for when the offset is 0
+    std::uint64_t high { (words[word + 1] << 1) << (bits_per_word - 1 - offset) };
+
+    return (low | high) & mask_of(bit_width);
+}
+
+inline void write(std::uint64_t* words, std::size_t bit_position, unsigned bit_width, std::uint64_t value) noexcept
+{
+    std::size_t word { bit_position / bits_per_word };
+    unsigned offset { static_cast<unsigned>(bit_position % bits_per_word) };
+    std::uint64_t mask { mask_of(bit_width) };
+
+    words[word] = (words[word] & ~(mask << offset)) | (value << offset);
+
+    if ((offset + bit_width) > bits_per_word)
+    {
+        unsigned written { static_cast<unsigned>(bits_per_word) - offset };
+
+        words[word + 1] = (words[word + 1] & ~(mask >> written)) | (value >> written);
+    }
+}
+
+} // namespace bit_packing end
+
+class PackedIntArray final
+{
+public:
+    using value_type = std::uint64_t;
+    using size_type = std::size_t;
+
+    struct ConstIterator final
+    {
+        using difference_type = std::ptrdiff_t;
+
+        using value_type = std::uint64_t;
+
+        // The elements are decoded on the fly, so the iterator returns them by value
+        using reference = std::uint64_t;
+
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
+
+    private:
+        const PackedIntArray* m_array { nullptr };
+        std::size_t m_index {};
+
+    public:
+        ConstIterator() = default;
+
+        ConstIterator(const PackedIntArray* array, std::size_t index)
+        : m_array { array },
+          m_index { index } {}
+
+        reference operator*() const
+        {
+            return (*m_array)[m_index];
+        }
+
+        reference operator[](const difference_type position) const
+        {
+            return (*m_array)[m_index + static_cast<std::size_t>(position)];
+        }
+
+        ConstIterator& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        ConstIterator operator++(int)
+        {
+            ConstIterator iterator { *this };
+            ++(*this);
+            return iterator;
+        }
+
+        ConstIterator& operator--()
+        {
+            --m_index;
+            return *this;
+        }
+
+        ConstIterator operator--(int)
+        {
+            ConstIterator iterator { *this };
+            --(*this);
+            return iterator;
+        }
+
+        ConstIterator& operator+=(const difference_type x)
+        {
+            m_index += static_cast<std::size_t>(x);
+            return *this;
+        }
+
+        ConstIterator& operator-=(const difference_type x)
+        {
+            m_index -= static_cast<std::size_t>(x);
+            return *this;
+        }
+
+        ConstIterator operator+(const difference_type x) const
+        {
+            return ConstIterator { m_array, m_index + static_cast<std::size_t>(x) };
+        }
+
+        ConstIterator operator-(const difference_type x) const
+        {
+            return ConstIterator { m_array, m_index - static_cast<std::size_t>(x) };
+        }
+
+        friend ConstIterator operator+(const difference_type x, const ConstIterator& it)
+        {
+            return it + x;
+        }
+
+        difference_type operator-(const ConstIterator& other) const
+        {
+            return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index);
+        }
+
+        friend bool operator==(const ConstIterator& a, const ConstIterator& other)
+        {
+            return (a.m_index == other.m_index);
+        }
+
+        friend auto operator<=>(const ConstIterator& a, const ConstIterator& other)
+        {
+            return (a.m_index <=> other.m_index);
+        }
+    };
+
+    using const_iterator = ConstIterator;
+
+private:
+    SilentDynArray<std::uint64_t> m_words {};
+    std::size_t m_size {};
+    unsigned m_bit_width { 1 };
+
+    // One extra word at the end, see bit_packing::read()
+    static std::size_t words_for(std::size_t element_amount, unsigned bit_width) noexcept
+    {
+        return ((element_amount * bit_width) + bit_packing::bits_per_word - 1) / bit_packing::bits_per_word + 1;
+    }
+
+    void ensure_words(std::size_t element_amount)
+    {
+        std::size_t word_amount { words_for(element_amount, m_bit_width) };
+
+        if (word_amount > m_words.size())
+        {
+            // Growing by 2 like DynArray does, instead of one word at a time
+            if (word_amount > m_words.capacity())
+            {
+                m_words.reserve_memory((word_amount > (m_words.capacity() * 2)) ? word_amount : (m_words.capacity() * 2));
+            }
+
+            m_words.resize(word_amount, 0);
+        }
+    }
+
+public:
+    // The elements start with "bit_width" bits, from 1 to 64
+    explicit PackedIntArray(unsigned bit_width = 1)
+    : m_bit_width { bit_width }
+    {
+        BASIC_ASSERT(((bit_width >= 1) && (bit_width <= 64)), "The bit width must be between 1 and 64.\n");
+    }
+
+    PackedIntArray(std::size_t size, unsigned bit_width, std::uint64_t value = 0)
+    : PackedIntArray(bit_width)
+    {
+        resize(size, value);
+    }
+
+    std::size_t size() const noexcept { return m_size; }
+
+    bool is_empty() const noexcept { return (m_size == 0); }
+
+    unsigned bit_width() const noexcept { return m_bit_width; }
+
+    // How many elements fit without reallocating, with the current width
+    std::size_t capacity() const noexcept
+    {
+        return (m_words.capacity() > 0) ? ((m_words.capacity() - 1) * bit_packing::bits_per_word) / m_bit_width : 0;
+    }
+
+    std::size_t memory_bytes() const noexcept { return m_words.capacity() * sizeof(std::uint64_t); }
+
+    const std::uint64_t* words() const noexcept { return m_words.data(); }
+
+    void reserve_memory(std::size_t element_amount)
+    {
+        std::size_t word_amount { words_for(element_amount, m_bit_width) };
+
+        if (word_amount > m_words.capacity())
+        {
+            m_words.reserve_memory(word_amount);
+        }
+    }
+
+    // It re-encodes every element with "bit_width" bits. It can only make the elements wider
+    void widen(unsigned bit_width)
+    {
+        BASIC_ASSERT(((bit_width >= m_bit_width) && (bit_width <= 64)), "The new bit width must be between the current one and 64.\n");
+
+        if (bit_width == m_bit_width)
+        {
+            return;
+        }
+
+        SilentDynArray<std::uint64_t> words {};
+        words.resize(words_for(m_size, bit_width), 0);
+
+        for (std::size_t i {}; i < m_size; i++)
+        {
+            bit_packing::write(words.data(), i * bit_width, bit_width, (*this)[i]);
+        }
+
+        m_words = std::move(words);
+        m_bit_width = bit_width;
+    }
+
+    std::uint64_t operator[](std::size_t position) const noexcept
+    {
+        return bit_packing::read(m_words.data(), position * m_bit_width, m_bit_width);
+    }
+
+    // It works the same as operator[] but it has bounds checking
+    std::uint64_t at_checked(std::size_t position) const
+    {
+        BASIC_ASSERT((position < m_size), "The position must be a positive number and not bigger than the size of the PackedIntArray.\n");
+
+        return (*this)[position];
+    }
+
+    // The array gets wider if "value" doesn't fit
+    void set(std::size_t position, std::uint64_t value)
+    {
+        BASIC_ASSERT((position < m_size), "The position must be a positive number and not bigger than the size of the PackedIntArray.\n");
+
+        if (bit_packing::width_of(value) > m_bit_width)
+        {
+            widen(bit_packing::width_of(value));
+        }
+
+        bit_packing::write(m_words.data(), position * m_bit_width, m_bit_width, value);
+    }
+
+    void push_back(std::uint64_t value)
+    {
+        if (bit_packing::width_of(value) > m_bit_width)
+        {
+            widen(bit_packing::width_of(value));
+        }
+
+        ensure_words(m_size + 1);
+        bit_packing::write(m_words.data(), m_size * m_bit_width, m_bit_width, value);
+        m_size++;
+    }
+
+    void pop_back()
+    {
+        if (is_empty())
+        {
+            std::cout << "The PackedIntArray is already empty, no elements will be popped out.\n";
+            return;
+        }
+
+        m_size--;
+    }
+
+    // Changes the size of the array and sets the new elements to "value"
+    void resize(std::size_t element_amount, std::uint64_t value = 0)
+    {
+        if (bit_packing::width_of(value) > m_bit_width)
+        {
+            widen(bit_packing::width_of(value));
+        }
+
+        ensure_words(element_amount);
+
+        for (std::size_t i { m_size }; i < element_amount; i++)
+        {
+            bit_packing::write(m_words.data(), i * m_bit_width, m_bit_width, value);
+        }
+
+        m_size = element_amount;
+    }
+
+    void clear() noexcept
+    {
+        m_words.destroy_all();
+        m_size = 0;
+    }
+
+    // It unpacks "amount" elements starting at "first" into "out", walking the words only once
+    void decode(std::size_t first, std::size_t amount, std::uint64_t* out) const
+    {
+        BASIC_ASSERT(((first <= m_size) && (amount <= (m_size - first))), "The range to decode is out of the PackedIntArray.\n");
+
+        const std::uint64_t* words { m_words.data() };
+        std::size_t bit_position { first * m_bit_width };
+
+        for (std::size_t i {}; i < amount; i++)
+        {
+            out[i] = bit_packing::read(words, bit_position, m_bit_width);
+            bit_position += m_bit_width;
+        }
+    }
+
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+    const_iterator end() const noexcept { return const_iterator(this, m_size); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+};
+
+class DeltaArray final
+{
+public:
+    using value_type = std::uint64_t;
+    using size_type = std::size_t;
+
+    static constexpr std::size_t block_size { 128 };
+
+    struct ConstIterator final
+    {
+        using difference_type = std::ptrdiff_t;
+
+        using value_type = std::uint64_t;
+
+        // The elements are decoded on the fly, so the iterator returns them by value
+        using reference = std::uint64_t;
+
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
+
+    private:
+        const DeltaArray* m_array { nullptr };
+        std::size_t m_index {};
+
+    public:
+        ConstIterator() = default;
+
+        ConstIterator(const DeltaArray* array, std::size_t index)
+        : m_array { array },
+          m_index { index } {}
+
+        reference operator*() const
+        {
+            return (*m_array)[m_index];
+        }
+
+        reference operator[](const difference_type position) const
+        {
+            return (*m_array)[m_index + static_cast<std::size_t>(position)];
+        }
+
+        ConstIterator& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        ConstIterator operator++(int)
+        {
+            ConstIterator iterator { *this };
+            ++(*this);
+            return iterator;
+        }
+
+        ConstIterator& operator--()
+        {
+            --m_index;
+            return *this;
+        }
+
+        ConstIterator operator--(int)
+        {
+            ConstIterator iterator { *this };
+            --(*this);
+            return iterator;
+        }
+
+        ConstIterator& operator+=(const difference_type x)
+        {
+            m_index += static_cast<std::size_t>(x);
+            return *this;
+        }
+
+        ConstIterator& operator-=(const difference_type x)
+        {
+            m_index -= static_cast<std::size_t>(x);
+            return *this;
+        }
+
+        ConstIterator operator+(const difference_type x) const
+        {
+            return ConstIterator { m_array, m_index + static_cast<std::size_t>(x) };
+        }
+
+        ConstIterator operator-(const difference_type x) const
+        {
+            return ConstIterator { m_array, m_index - static_cast<std::size_t>(x) };
+        }
+
+        friend ConstIterator operator+(const difference_type x, const ConstIterator& it)
+        {
+            return it + x;
+        }
+
+        difference_type operator-(const ConstIterator& other) const
+        {
+            return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index);
+        }
+
+        friend bool operator==(const ConstIterator& a, const ConstIterator& other)
+        {
+            return (a.m_index == other.m_index);
+        }
+
+        friend auto operator<=>(const ConstIterator& a, const ConstIterator& other)
+        {
+            return (a.m_index <=> other.m_index);
+        }
+    };
+
+    using const_iterator = ConstIterator;
+
+private:
+    struct Block final
+    {
+        std::uint64_t base {};          // The first (and smallest) value of the block
+        std::size_t first_word {};      // Where its packed distances start in m_words
+        unsigned bit_width {};          // 0 when all the values of the block are the same
+    };
+
+    using UnpackFunction = void (*)(const std::uint64_t*, std::uint64_t, std::uint64_t*);
+
+    SilentDynArray<Block> m_blocks {};
+    SilentDynArray<std::uint64_t> m_words {};     // With one extra word at the end, see bit_packing::read()
+    SilentDynArray<std::uint64_t> m_tail {};      // The last elements, until they fill a block
+    std::size_t m_size {};
+
+    // With the width known at compile time every shift and mask is a constant, so the compiler can
+    // unroll and vectorize the loop. A block always takes a whole number of words (128 * width bits)
+    template<unsigned BitWidth>
+    static void unpack_block(const std::uint64_t* words, std::uint64_t base, std::uint64_t* out) noexcept
+    {
+        for (std::size_t i {}; i < block_size; i++)
+        {
+            if constexpr (BitWidth == 0)
+            {
+                out[i] = base;
+            }
+            else
+            {
+                out[i] = base + bit_packing::read(words, i * BitWidth, BitWidth);
+            }
+        }
+    }
+
+    template<std::size_t... Widths>
+    static constexpr std::array<UnpackFunction, sizeof...(Widths)> make_unpack_table(std::index_sequence<Widths...>) noexcept
+    {
+        return { &unpack_block<static_cast<unsigned>(Widths)>... };
+    }
+
+    static UnpackFunction unpack_function(unsigned bit_width) noexcept
+    {
+        static constexpr std::array<UnpackFunction, 65> table { make_unpack_table(std::make_index_sequence<65> {}) };
+
+        return table[bit_width];
+    }
+
+    // It compresses the tail into a new block
+    void seal_tail()
+    {
+        std::uint64_t base { m_tail[0] };
+        std::uint64_t range { m_tail[block_size - 1] - base };
+        unsigned bit_width { (range == 0) ? 0u : static_cast<unsigned>(std::bit_width(range)) };
+
+        std::size_t first_word { m_words.is_empty() ? 0 : (m_words.size() - 1) };
+        std::size_t word_amount { first_word + ((block_size * bit_width) / bit_packing::bits_per_word) + 1 };
+
+        if (word_amount > m_words.capacity())
+        {
+            m_words.reserve_memory((word_amount > (m_words.capacity() * 2)) ? word_amount : (m_words.capacity() * 2));
+        }
+
+        m_words.resize(word_amount, 0);
+
+        for (std::size_t i {}; (bit_width > 0) && (i < block_size); i++)
+        {
+            bit_packing::write(m_words.data() + first_word, i * bit_width, bit_width, m_tail[i] - base);
+        }
+
+        m_blocks.push_back(Block { base, first_word, bit_width });
+        m_tail.destroy_all();
+    }
+
+public:
+    DeltaArray() = default;
+
+    std::size_t size() const noexcept { return m_size; }
+
+    bool is_empty() const noexcept { return (m_size == 0); }
+
+    std::size_t block_count() const noexcept { return m_blocks.size(); }
+
+    std::size_t memory_bytes() const noexcept
+    {
+        return (m_blocks.capacity() * sizeof(Block)) + ((m_words.capacity() + m_tail.capacity()) * sizeof(std::uint64_t));
+    }
+
+    // The values must come in non-decreasing order
+    void push_back(std::uint64_t value)
+    {
+        BASIC_ASSERT((is_empty() || (value >= last())), "The values of a DeltaArray must be sorted, the new one is smaller than the last one.\n");
+
+        if (m_tail.capacity() == 0)
+        {
+            m_tail.reserve_memory(block_size);
+        }
+
+        m_tail.push_back(value);
+        m_size++;
+
+        if (m_tail.size() == block_size)
+        {
+            seal_tail();
+        }
+    }
+
+    std::uint64_t operator[](std::size_t position) const noexcept
+    {
+        std::size_t block { position / block_size };
+
+        if (block == m_blocks.size())
+        {
+            return m_tail[position % block_size];
+        }
+
+        const Block& b { m_blocks[block] };
+
+        if (b.bit_width == 0)
+        {
+            return b.base;
+        }
+
+        return b.base + bit_packing::read(m_words.data() + b.first_word, (position % block_size) * b.bit_width, b.bit_width);
+    }
+
+    // It works the same as operator[] but it has bounds checking
+    std::uint64_t at_checked(std::size_t position) const
+    {
+        BASIC_ASSERT((position < m_size), "The position must be a positive number and not bigger than the size of the DeltaArray.\n");
+
+        return (*this)[position];
+    }
+
+    std::uint64_t last() const
+    {
+        BASIC_ASSERT(!is_empty(), "The DeltaArray is empty, you can't get the last element.\n");
+
+        return (*this)[m_size - 1];
+    }
+
+    void clear() noexcept
+    {
+        m_blocks.destroy_all();
+        m_words.destroy_all();
+        m_tail.destroy_all();
+        m_size = 0;
+    }
+
+    // It unpacks "amount" elements starting at "first" into "out". Whole blocks go through the unpack
+    // function specialized for their width
+    void decode(std::size_t first, std::size_t amount, std::uint64_t* out) const
+    {
+        BASIC_ASSERT(((first <= m_size) && (amount <= (m_size - first))), "The range to decode is out of the DeltaArray.\n");
+
+        std::size_t last_position { first + amount };
+
+        while (first < last_position)
+        {
+            std::size_t block { first / block_size };
+
+            if (((first % block_size) == 0) && ((last_position - first) >= block_size) && (block < m_blocks.size()))
+            {
+                const Block& b { m_blocks[block] };
+
+                unpack_function(b.bit_width)(m_words.data() + b.first_word, b.base, out);
+
+                out += block_size;
+                first += block_size;
+            }
+            else
+            {
+                *out = (*this)[first];
+
+                out++;
+                first++;
+            }
+        }
+    }
+
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+    const_iterator end() const noexcept { return const_iterator(this, m_size); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+};
+
+} // namespace hdsa end
+
+#endif // PACKED_INT_ARRAY_HPP
@@ -0,0 +1,354 @@
+#ifndef PARALLEL_ALGORITHMS_HPP
+#define PARALLEL_ALGORITHMS_HPP
+
+#include "dyn_array.hpp"
+#include "thread_pool.hpp"
+
+#include <cstddef>
+#include <ranges>
+#include <functional>
+#include <utility>
+
+/**
+ * Parallel versions of some basic algorithms, running on a ThreadPool (the shared default one unless
+ * another is given). They take any contiguous range, so DynArrays, std::spans and the field spans of a
+ * SoADynArray all work.
+ * All of them use the same two-pass blocked scheme: the input is split into a few blocks per thread,
+ * the first pass computes something small for every block in parallel (a sum, a count, a histogram),
+ * those results are combined serially, and when needed a second pass finishes every block in parallel
+ * using its combined offset. The inner loops are plain loops over contiguous memory, so the compiler
+ * can vectorize them. Inputs that are too small to be worth splitting run serially.
+*/
+
+namespace hdsa
+{
+
+namespace parallel_detail
+{
+
+// Below this amount of elements per block the overhead of the pool isn't worth it
+inline constexpr std::size_t min_block_size { 16384 };
+
+struct BlockPlan final
+{
+    std::size_t size {};
+    std::size_t block_count {};
+    std::size_t block_size {};
+
+    std::size_t first(std::size_t block) const noexcept { return block * block_size; }
+
+    std::size_t last(std::size_t block) const noexcept
+    {
+        std::size_t end { (block + 1) * block_size };
+        return (end < size) ? end : size;
+    }
+};
+
+// Around 4 blocks per thread, so the threads that finish early can steal the blocks of the slow ones
+inline BlockPlan plan_blocks(std::size_t size, const ThreadPool& pool) noexcept
+{
+    std::size_t block_count { pool.thread_count() * 4 };
+    std::size_t max_blocks { (size + min_block_size - 1) / min_block_size };
+
+    block_count = (block_count < max_blocks) ? block_count : max_blocks;
+    block_count = (block_count == 0) ? 1 : block_count;
+
+    return BlockPlan { size, block_count, (size + block_count - 1) / block_count };
+}
+
+} // namespace parallel_detail end
+
+// output[i] = input[0] op input[1] op ... op input[i]. The output can be the input itself, and "op" must be associative
+template<std::ranges::contiguous_range Input, std::ranges::contiguous_range Output, typename BinaryOperation = std::plus<>>
+void inclusive_scan(const Input& input, Output&& output, BinaryOperation op = {}, ThreadPool& pool = default_thread_pool())
+{
+    using T = std::ranges::range_value_t<Output>;
+
+    std::size_t size { static_cast<std::size_t>(std::ranges::size(input)) };
+
+    BASIC_ASSERT((static_cast<std::size_t>(std::ranges::size(output)) >= size), "The output must be at least as big as the input.\n");
+
+    if (size == 0)
+    {
+        return;
+    }
+
+    const auto* in { std::ranges::data(input) };
+    T* out { std::ranges::data(output) };
+
+    parallel_detail::BlockPlan plan { parallel_detail::plan_blocks(size, pool) };
+
+    // First pass: the total of every block
+    SilentDynArray<T> totals {};
+    totals.resize(plan.block_count);
+
+    pool.parallel_for(0, plan.block_count, [&](std::size_t block)
+    {
+        std::size_t first { plan.first(block) };
+        T total { in[first] };
+
+        for (std::size_t i { first + 1 }; i < plan.last(block); i++)
+        {
+            total = op(total, in[i]);
+        }
+
+        totals[block] = total;
+    }, 1);
+
+    // Every block starts from the total of all the blocks before it
+    for (std::size_t block { 1 }; block < plan.block_count; block++)
+    {
+        totals[block] = op(totals[block - 1], totals[block]);
+    }
+
+    // Second pass: the scan of every block, starting from its offset
+    pool.parallel_for(0, plan.block_count, [&](std::size_t block)
+    {
+        std::size_t first { plan.first(block) };
+        T running { (block == 0) ? T(in[first]) : op(totals[block - 1], in[first]) };
+
+        out[first] = running;
+
+        for (std::size_t i { first + 1 }; i < plan.last(block); i++)
+        {
+            running = op(running, in[i]);
+            out[i] = running;
+        }
+    }, 1);
+}
+
+// output[i] = init op input[0] op ... op input[i - 1]. The output can be the input itself, and "op" must be associative
+template<std::ranges::contiguous_range Input, std::ranges::contiguous_range Output, typename T, typename BinaryOperation = std::plus<>>
+void exclusive_scan(const Input& input, Output&& output, T init, BinaryOperation op = {}, ThreadPool& pool = default_thread_pool())
+{
+    std::size_t size { static_cast<std::size_t>(std::ranges::size(input)) };
+
+    BASIC_ASSERT((static_cast<std::size_t>(std::ranges::size(output)) >= size), "The output must be at least as big as the input.\n");
+
+    if (size == 0)
+    {
+        return;
+    }
+
+    const auto* in { std::ranges::data(input) };
+    auto* out { std::ranges::data(output) };
+
+    parallel_detail::BlockPlan plan { parallel_detail::plan_blocks(size, pool) };
+
+    SilentDynArray<T> totals {};
+    totals.resize(plan.block_count);
+
+    pool.parallel_for(0, plan.block_count, [&](std::size_t block)
+    {
+        std::size_t first { plan.first(block) };
+        T total { in[first] };
+
+        for (std::size_t i { first + 1 }; i < plan.last(block); i++)
+        {
+            total = op(total, in[i]);
+        }
+
+        totals[block] = total;
+    }, 1);
+
+    // The totals become the starting value of every block
+    T running { init };
+
+    for (std::size_t block {}; block < plan.block_count; block++)
+    {
+        T total { std::move(totals[block]) };
+
+        totals[block] = running;
+        running = op(running, total);
+    }
+
+    pool.parallel_for(0, plan.block_count, [&](std::size_t block)
+    {
+        T block_running { totals[block] };
+
+        for (std::size_t i { plan.first(block) }; i < plan.last(block); i++)
+        {
+            // Read before writing, in case the output is the input
+            T value { in[i] };
+
+            out[i] = block_running;
+            block_running = op(block_running, value);
+        }
+    }, 1);
+}
+
+// init reduce transform(input[0]) reduce ... reduce transform(input[n - 1]), "reduce" must be associative and commutative
+template<std::ranges::contiguous_range Input, typename T, typename Reduce, typename Transform>
+T transform_reduce(const Input& input, T init, Reduce reduce, Transform transform, ThreadPool& pool = default_thread_pool())
+{
+    std::size_t size { static_cast<std::size_t>(std::ranges::size(input)) };
+
+    if (size == 0)
+    {
+        return init;
+    }
+
+    const auto* in { std::ranges::data(input) };
+
+    parallel_detail::BlockPlan plan { parallel_detail::plan_blocks(size, pool) };
+
+    SilentDynArray<T> partials {};
+    partials.resize(plan.block_count);
+
+    pool.parallel_for(0, plan.block_count, [&](std::size_t block)
+    {
+        std::size_t first { plan.first(block) };
+        T partial { transform(in[first]) };
+
+        for (std::size_t i { first + 1 }; i < plan.last(block); i++)
+        {
+            partial = reduce(partial, transform(in[i]));
+        }
+
+        partials[block] = partial;
+    }, 1);
+
+    for (std::size_t block {}; block < plan.block_count; block++)
+    {
+        init = reduce(init, partials[block]);
+    }
+
+    return init;
+}
+
+// It counts how many elements fall in every bucket, "bucket_of" must return a value from 0 to bucket_count - 1.
+// Every block fills its own histogram, so there are no atomic operations, and then they're added together
+template<std::ranges::contiguous_range Input, typename BucketOf>
+DynArray<std::size_t> parallel_histogram(const Input& input, std::size_t bucket_count, BucketOf bucket_of, ThreadPool& pool = default_thread_pool())
+{
+    std::size_t size { static_cast<std::size_t>(std::ranges::size(input)) };
+    const auto* in { std::ranges::data(input) };
+
+    DynArray<std::size_t> histogram {};
+    histogram.resize(bucket_count, 0);
+
+    if ((size == 0) || (bucket_count == 0))
+    {
+        return histogram;
+    }
+
+    parallel_detail::BlockPlan plan { parallel_detail::plan_blocks(size, pool) };
+
+    // A single flat buffer with one histogram per block
+    SilentDynArray<std::size_t> local {};
+    local.resize(plan.block_count * bucket_count, 0);
+
+    pool.parallel_for(0, plan.block_count, [&](std::size_t block)
+    {
+        std::size_t* counts { local.data() + (block * bucket_count) };
+
+        for (std::size_t i { plan.first(block) }; i < plan.last(block); i++)
+        {
+            std::size_t bucket { static_cast<std::size_t>(bucket_of(in[i])) };
+
+            BASIC_ASSERT((bucket < bucket_count), "bucket_of() returned a bucket out of the histogram.\n");
+
+            counts[bucket]++;
+        }
+    }, 1);
+
+    for (std::size_t block {}; block < plan.block_count; block++)
+    {
+        const std::size_t* counts { local.data() + (block * bucket_count) };
+
+        for (std::size_t bucket {}; bucket < bucket_count; bucket++)
+        {
+            histogram[bucket] += counts[bucket];
+        }
+    }
+
+    return histogram;
+}
+
+// A stable partition: the elements that satisfy "predicate" go first and both groups keep their order.
+// It returns the amount of elements that satisfy it. The first pass counts them per block, and the second
+// moves every element to its final spot in a temporary DynArray, which needs T to be default constructible
+template<std::ranges::contiguous_range Range, typename Predicate>
+std::size_t parallel_partition(Range&& range, Predicate predicate, ThreadPool& pool = default_thread_pool())
+{
+    using T = std::ranges::range_value_t<Range>;
+
+    std::size_t size { static_cast<std::size_t>(std::ranges::size(range)) };
+
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    T* elements { std::ranges::data(range) };
+
+    parallel_detail::BlockPlan plan { parallel_detail::plan_blocks(size, pool) };
+
+    SilentDynArray<std::size_t> selected {};
+    selected.resize(plan.block_count, 0);
+
+    pool.parallel_for(0, plan.block_count, [&](std::size_t block)
+    {
+        std::size_t count {};
+
+        for (std::size_t i { plan.first(block) }; i < plan.last(block); i++)
+        {
+            count += static_cast<std::size_t>(static_cast<bool>(predicate(std::as_const(elements[i]))));
+        }
+
+        selected[block] = count;
+    }, 1);
+
+    // Where every block starts writing its selected and its rejected elements
+    SilentDynArray<std::size_t> selected_offsets {};
+    SilentDynArray<std::size_t> rejected_offsets {};
+    selected_offsets.resize(plan.block_count, 0);
+    rejected_offsets.resize(plan.block_count, 0);
+
+    std::size_t total_selected {};
+
+    for (std::size_t block {}; block < plan.block_count; block++)
+    {
+        selected_offsets[block] = total_selected;
+        total_selected += selected[block];
+    }
+
+    std::size_t rejected_so_far {};
+
+    for (std::size_t block {}; block < plan.block_count; block++)
+    {
+        rejected_offsets[block] = total_selected + rejected_so_far;
+        rejected_so_far += (plan.last(block) - plan.first(block)) - selected[block];
+    }
+
+    SilentDynArray<T> partitioned {};
+    partitioned.resize(size);
+
+    pool.parallel_for(0, plan.block_count, [&](std::size_t block)
+    {
+        std::size_t next_selected { selected_offsets[block] };
+        std::size_t next_rejected { rejected_offsets[block] };
+
+        for (std::size_t i { plan.first(block) }; i < plan.last(block); i++)
+        {
+            std::size_t& next { predicate(std::as_const(elements[i])) ? next_selected : next_rejected };
+
+            partitioned[next] = std::move(elements[i]);
+            next++;
+        }
+    }, 1);
+
+    pool.parallel_for(0, size, [&](std::size_t first, std::size_t last)
+    {
+        for (std::size_t i { first }; i < last; i++)
+        {
+            elements[i] = std::move(partitioned[i]);
+        }
+    }, plan.block_size);
+
+    return total_selected;
+}
+
+} // namespace hdsa end
+
+#endif // PARALLEL_ALGORITHMS_HPP
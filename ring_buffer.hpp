@@ -0,0 +1,524 @@
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+#include "dyn_array.hpp"
+
+#include <cstddef>
+#include <bit>
+#include <limits>
+#include <type_traits>
+#include <iterator>
+#include <new>
+#include <iostream>
+#include <utility>
+#include <initializer_list>
+#include <span>
+
+/**
+ * Personal implementation of a growable circular buffer that works as a double-ended queue, with
+ * O(1) insertion and removal at both ends. The capacity is always a power of 2, so positions wrap
+ * around with a mask instead of a modulo.
+ * The elements are contiguous in memory except for the wrap-around point, so as_spans() can give
+ * all of them as at most two std::spans, ready for vectorized loops or writev.
+ * It grows like DynArray does, by a factor of 2 with ::operator new and moving the elements.
+*/
+
+namespace hdsa
+{
+
+template<typename T>
+class RingBuffer final
+{
+public:
+    using value_type = T;
+
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+private:
+    T* m_first_ptr { nullptr };
+    std::size_t m_head {};           // Position in the buffer of the first element
+    std::size_t m_size {};
+    std::size_t m_capacity {};
+
+    std::size_t physical(std::size_t position) const noexcept
+    {
+        return (m_head + position) & (m_capacity - 1);
+    }
+
+    // It moves all the elements into "new_buffer", which has "element_amount" spots, unwrapping them so
+    // the first one ends up at the start of it
+    void move_into(T* new_buffer, std::size_t element_amount)
+    {
+        for (std::size_t i {}; i < m_size; i++)
+        {
+            T& old_element { m_first_ptr[physical(i)] };
+
+            new (new_buffer + i) T(std::move_if_noexcept(old_element));
+            old_element.~T();
+        }
+
+        if (m_first_ptr != nullptr)
+        {
+            ::operator delete(m_first_ptr, m_capacity * sizeof(T));
+        }
+
+        m_first_ptr = new_buffer;
+        m_capacity = element_amount;
+        m_head = 0;
+    }
+
+    void mem_realloc(std::size_t element_amount)
+    {
+        move_into(static_cast<T*>(::operator new(element_amount * sizeof(T))), element_amount);
+    }
+
+    // It's only called when the RingBuffer is full. The new element is built in the new buffer before the
+    // old ones are moved there, because "args" can refer to one of them (like in push_back(first()))
+    template<typename... Args>
+    T& grow_and_emplace(bool at_front, Args&&... args)
+    {
+        BASIC_ASSERT((m_capacity <= (std::numeric_limits<std::size_t>::max() / 2)), "The RingBuffer has reached the limit of std::size_t, so it cannot grow any further.\n");
+
+        std::size_t new_capacity { (m_capacity == 0) ? 1 : (m_capacity * 2) };
+        T* new_buffer { static_cast<T*>(::operator new(new_capacity * sizeof(T))) };
+
+        // At the front the new element takes the last spot, which comes right before the unwrapped old ones
+        std::size_t spot { at_front ? (new_capacity - 1) : m_size };
+
+        new (new_buffer + spot) T(std::forward<Args>(args)...);
+        move_into(new_buffer, new_capacity);
+
+        if (at_front)
+        {
+            m_head = spot;
+        }
+
+        m_size++;
+
+        return m_first_ptr[spot];
+    }
+
+    template<bool IsConst>
+    struct RingIterator final
+    {
+        using difference_type = std::ptrdiff_t;
+
+        using value_type = RingBuffer::value_type;
+
+        using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+
+        using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
+
+    private:
+        using ring_pointer = std::conditional_t<IsConst, const RingBuffer*, RingBuffer*>;
+
+        ring_pointer m_ring { nullptr };
+        std::size_t m_index {};
+
+        friend class RingBuffer;
+
+    public:
+        RingIterator() = default;
+
+        RingIterator(ring_pointer ring, std::size_t index)
+        : m_ring { ring },
+          m_index { index } {}
+
+        // Every iterator can be used where a const iterator is expected
+        template<bool OtherConst>
+        requires (IsConst && !OtherConst)
+        RingIterator(const RingIterator<OtherConst>& other)
+        : m_ring { other.m_ring },
+          m_index { other.m_index } {}
+
+        reference operator*() const
+        {
+            return (*m_ring)[m_index];
+        }
+
+        pointer operator->() const
+        {
+            return &(*m_ring)[m_index];
+        }
+
+        reference operator[](const difference_type position) const
+        {
+            return (*m_ring)[m_index + static_cast<std::size_t>(position)];
+        }
+
+        RingIterator& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        RingIterator operator++(int)
+        {
+            RingIterator iterator { *this };
+            ++(*this);
+            return iterator;
+        }
+
+        RingIterator& operator--()
+        {
+            --m_index;
+            return *this;
+        }
+
+        RingIterator operator--(int)
+        {
+            RingIterator iterator { *this };
+            --(*this);
+            return iterator;
+        }
+
+        RingIterator& operator+=(const difference_type x)
+        {
+            m_index += static_cast<std::size_t>(x);
+            return *this;
+        }
+
+        RingIterator& operator-=(const difference_type x)
+        {
+            m_index -= static_cast<std::size_t>(x);
+            return *this;
+        }
+
+        RingIterator operator+(const difference_type x) const
+        {
+            return RingIterator { m_ring, m_index + static_cast<std::size_t>(x) };
+        }
+
+        RingIterator operator-(const difference_type x) const
+        {
+            return RingIterator { m_ring, m_index - static_cast<std::size_t>(x) };
+        }
+
+        friend RingIterator operator+(const difference_type x, const RingIterator& it)
+        {
+            return it + x;
+        }
+
+        difference_type operator-(const RingIterator& other) const
+        {
+            return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index);
+        }
+
+        friend bool operator==(const RingIterator& a, const RingIterator& other)
+        {
+            return (a.m_index == other.m_index);
+        }
+
+        friend auto operator<=>(const RingIterator& a, const RingIterator& other)
+        {
+            return (a.m_index <=> other.m_index);
+        }
+    };
+
+public:
+    using iterator = RingIterator<false>;
+    using const_iterator = RingIterator<true>;
+
+    // The contents of the RingBuffer in order, the second span is empty when the elements don't wrap around
+    template<typename U>
+    struct Spans final
+    {
+        std::span<U> first {};
+        std::span<U> second {};
+    };
+
+    RingBuffer() = default;
+
+    RingBuffer(std::initializer_list<T> other)
+    {
+        reserve_memory(other.size());
+
+        for (const T& t : other)
+        {
+            push_back(t);
+        }
+    }
+
+    RingBuffer(const RingBuffer& other)
+    {
+        reserve_memory(other.m_size);
+
+        for (std::size_t i {}; i < other.m_size; i++)
+        {
+            push_back(other[i]);
+        }
+    }
+
+    RingBuffer(RingBuffer&& other) noexcept
+    : m_first_ptr { std::exchange(other.m_first_ptr, nullptr) },
+      m_head { std::exchange(other.m_head, 0) },
+      m_size { std::exchange(other.m_size, 0) },
+      m_capacity { std::exchange(other.m_capacity, 0) }
+    {}
+
+    RingBuffer& operator=(const RingBuffer& other)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        clear();
+        reserve_memory(other.m_size);
+
+        for (std::size_t i {}; i < other.m_size; i++)
+        {
+            push_back(other[i]);
+        }
+
+        return *this;
+    }
+
+    RingBuffer& operator=(RingBuffer&& other) noexcept
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        reset_array();
+
+        m_first_ptr = std::exchange(other.m_first_ptr, nullptr);
+        m_head = std::exchange(other.m_head, 0);
+        m_size = std::exchange(other.m_size, 0);
+        m_capacity = std::exchange(other.m_capacity, 0);
+
+        return *this;
+    }
+
+    ~RingBuffer()
+    {
+        reset_array();
+    }
+
+    bool is_empty() const noexcept { return (m_size == 0); }
+
+    bool is_full() const noexcept { return (m_size == m_capacity); }
+
+    std::size_t size() const noexcept { return m_size; }
+
+    std::size_t capacity() const noexcept { return m_capacity; }
+
+    // position 0 is always the first element, no matter where it is in the buffer
+    T& operator[](std::size_t position)
+    {
+        return m_first_ptr[physical(position)];
+    }
+
+    const T& operator[](std::size_t position) const
+    {
+        return m_first_ptr[physical(position)];
+    }
+
+    // It works the same as operator[] but it has bounds checking
+    T& at_checked(const std::size_t position)
+    {
+        BASIC_ASSERT((position < m_size), "The position must be a positive number and not bigger than the size of the RingBuffer.\n");
+
+        return m_first_ptr[physical(position)];
+    }
+
+    const T& at_checked(const std::size_t position) const
+    {
+        BASIC_ASSERT((position < m_size), "The position must be a positive number and not bigger than the size of the RingBuffer.\n");
+
+        return m_first_ptr[physical(position)];
+    }
+
+    T& first()
+    {
+        BASIC_ASSERT(!is_empty(), "The RingBuffer is empty, you can't get the first element.\n");
+
+        return m_first_ptr[m_head];
+    }
+
+    const T& first() const
+    {
+        BASIC_ASSERT(!is_empty(), "The RingBuffer is empty, you can't get the first element.\n");
+
+        return m_first_ptr[m_head];
+    }
+
+    T& last()
+    {
+        BASIC_ASSERT(!is_empty(), "The RingBuffer is empty, you can't get the last element.\n");
+
+        return m_first_ptr[physical(m_size - 1)];
+    }
+
+    const T& last() const
+    {
+        BASIC_ASSERT(!is_empty(), "The RingBuffer is empty, you can't get the last element.\n");
+
+        return m_first_ptr[physical(m_size - 1)];
+    }
+
+    // The capacity is rounded up to the next power of 2
+    void reserve_memory(std::size_t element_amount)
+    {
+        if (element_amount <= m_capacity)
+        {
+            return;
+        }
+
+        mem_realloc(std::bit_ceil(element_amount));
+    }
+
+    void push_back(const T& t)
+    {
+        emplace_back(t);
+    }
+
+    void push_back(T&& t)
+    {
+        emplace_back(std::move(t));
+    }
+
+    void push_front(const T& t)
+    {
+        emplace_front(t);
+    }
+
+    void push_front(T&& t)
+    {
+        emplace_front(std::move(t));
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (is_full())
+        {
+            return grow_and_emplace(false, std::forward<Args>(args)...);
+        }
+
+        T* spot { m_first_ptr + physical(m_size) };
+
+        new (spot) T(std::forward<Args>(args)...);
+        m_size++;
+
+        return *spot;
+    }
+
+    template<typename... Args>
+    T& emplace_front(Args&&... args)
+    {
+        if (is_full())
+        {
+            return grow_and_emplace(true, std::forward<Args>(args)...);
+        }
+
+        std::size_t new_head { (m_head - 1) & (m_capacity - 1) };
+
+        new (m_first_ptr + new_head) T(std::forward<Args>(args)...);
+        m_head = new_head;
+        m_size++;
+
+        return m_first_ptr[m_head];
+    }
+
+    void pop_front()
+    {
+        if (is_empty())
+        {
+            std::cout << "The RingBuffer is already empty, no elements will be popped out.\n";
+            return;
+        }
+
+        m_first_ptr[m_head].~T();
+        m_head = (m_head + 1) & (m_capacity - 1);
+        m_size--;
+    }
+
+    void pop_back()
+    {
+        if (is_empty())
+        {
+            std::cout << "The RingBuffer is already empty, no elements will be popped out.\n";
+            return;
+        }
+
+        m_size--;
+        m_first_ptr[physical(m_size)].~T();
+    }
+
+    // It destroys all the elements but keeps the buffer
+    void clear()
+    {
+        while (!is_empty())
+        {
+            pop_back();
+        }
+
+        m_head = 0;
+    }
+
+    // It destroys all the elements and deallocates the buffer
+    void reset_array()
+    {
+        clear();
+
+        if (m_first_ptr != nullptr)
+        {
+            ::operator delete(m_first_ptr, m_capacity * sizeof(T));
+            m_first_ptr = nullptr;
+        }
+
+        m_capacity = 0;
+    }
+
+    Spans<T> as_spans() noexcept
+    {
+        if ((m_head + m_size) <= m_capacity)
+        {
+            return Spans<T> { std::span<T> { m_first_ptr + m_head, m_size }, std::span<T> {} };
+        }
+
+        std::size_t first_part { m_capacity - m_head };
+
+        return Spans<T> { std::span<T> { m_first_ptr + m_head, first_part }, std::span<T> { m_first_ptr, m_size - first_part } };
+    }
+
+    Spans<const T> as_spans() const noexcept
+    {
+        if ((m_head + m_size) <= m_capacity)
+        {
+            return Spans<const T> { std::span<const T> { m_first_ptr + m_head, m_size }, std::span<const T> {} };
+        }
+
+        std::size_t first_part { m_capacity - m_head };
+
+        return Spans<const T> { std::span<const T> { m_first_ptr + m_head, first_part }, std::span<const T> { m_first_ptr, m_size - first_part } };
+    }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+
+    iterator end() noexcept { return iterator(this, m_size); }
+
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+    const_iterator end() const noexcept { return const_iterator(this, m_size); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+};
+
+} // namespace hdsa end
+
+#endif // RING_BUFFER_HPP
@@ -0,0 +1,257 @@
+#ifndef SLOT_MAP_HPP
+#define SLOT_MAP_HPP
+
+#include "dyn_array.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+/**
+ * Personal implementation of a slot map: a container that hands out stable handles to its elements
+ * while keeping the elements themselves densely packed in a DynArray, so iterating over them is a
+ * linear scan with no holes.
+ * Every handle points to a slot of an indirection array, and the slot knows where its element is
+ * right now. Erasing moves the last element into the hole (swap-and-pop) and fixes its slot, and the
+ * freed slots are reused by later insertions.
+ * Every slot also has a generation that's increased when its element is erased, so a handle to an
+ * erased element is detected as stale instead of silently pointing to whatever took its place.
+*/
+
+namespace hdsa
+{
+
+template<typename T>
+class SlotMap final
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    using iterator = typename SilentDynArray<T>::iterator;
+    using const_iterator = typename SilentDynArray<T>::const_iterator;
+
+    struct Handle final
+    {
+        std::uint32_t index { std::numeric_limits<std::uint32_t>::max() };
+        std::uint32_t generation {};
+
+        friend bool operator==(const Handle& a, const Handle& b) = default;
+    };
+
+private:
+    static constexpr std::uint32_t no_free_slot { std::numeric_limits<std::uint32_t>::max() };
+
+    struct Slot final
+    {
+        std::uint32_t index {};         // Position of the element in m_values, or the next free slot
+        std::uint32_t generation {};
+    };
+
+    SilentDynArray<T> m_values {};
+    SilentDynArray<std::uint32_t> m_value_to_slot {};     // The slot of every element, to fix it when the element moves
+    SilentDynArray<Slot> m_slots {};
+    std::uint32_t m_free_head { no_free_slot };
+
+    // It returns the position of the element in m_values, or size() if the handle is stale
+    std::size_t position_of(Handle handle) const noexcept
+    {
+        if ((handle.index >= m_slots.size()) || (m_slots[handle.index].generation != handle.generation))
+        {
+            return m_values.size();
+        }
+
+        return m_slots[handle.index].index;
+    }
+
+    // It takes a slot from the free list, or adds a new one if there are none
+    std::uint32_t acquire_slot()
+    {
+        if (m_free_head != no_free_slot)
+        {
+            std::uint32_t slot { m_free_head };
+            m_free_head = m_slots[slot].index;
+
+            return slot;
+        }
+
+        BASIC_ASSERT((m_slots.size() < no_free_slot), "The SlotMap has run out of 32 bits handles.\n");
+
+        m_slots.push_back(Slot {});
+
+        return static_cast<std::uint32_t>(m_slots.size() - 1);
+    }
+
+    // The generation changes, so every handle to the slot becomes stale
+    void release_slot(std::uint32_t slot)
+    {
+        m_slots[slot].generation++;
+        m_slots[slot].index = m_free_head;
+        m_free_head = slot;
+    }
+
+public:
+    SlotMap() = default;
+
+    std::size_t size() const noexcept { return m_values.size(); }
+
+    bool is_empty() const noexcept { return m_values.is_empty(); }
+
+    std::size_t capacity() const noexcept { return m_values.capacity(); }
+
+    void reserve_memory(std::size_t element_amount)
+    {
+        if (element_amount > m_values.capacity())
+        {
+            m_values.reserve_memory(element_amount);
+            m_value_to_slot.reserve_memory(element_amount);
+        }
+
+        if (element_amount > m_slots.capacity())
+        {
+            m_slots.reserve_memory(element_amount);
+        }
+    }
+
+    template<typename... Args>
+    Handle emplace(Args&&... args)
+    {
+        std::uint32_t slot { acquire_slot() };
+
+        m_values.emplace_back(std::forward<Args>(args)...);
+        m_value_to_slot.push_back(slot);
+        m_slots[slot].index = static_cast<std::uint32_t>(m_values.size() - 1);
+
+        return Handle { slot, m_slots[slot].generation };
+    }
+
+    Handle insert(const T& t)
+    {
+        return emplace(t);
+    }
+
+    Handle insert(T&& t)
+    {
+        return emplace(std::move(t));
+    }
+
+    // It returns false if the handle was already stale
+    bool erase(Handle handle)
+    {
+        std::size_t position { position_of(handle) };
+
+        if (position == m_values.size())
+        {
+            return false;
+        }
+
+        std::size_t last { m_values.size() - 1 };
+
+        // The last element takes the place of the erased one, so its slot has to point to the new position
+        if (position != last)
+        {
+            m_slots[m_value_to_slot[last]].index = static_cast<std::uint32_t>(position);
+        }
+
+        m_values.unordered_erase(m_values.cbegin() + static_cast<std::ptrdiff_t>(position));
+        m_value_to_slot.unordered_erase(m_value_to_slot.cbegin() + static_cast<std::ptrdiff_t>(position));
+
+        release_slot(handle.index);
+
+        return true;
+    }
+
+    bool contains(Handle handle) const noexcept
+    {
+        return (position_of(handle) != m_values.size());
+    }
+
+    // It returns nullptr if the handle is stale
+    T* get(Handle handle) noexcept
+    {
+        std::size_t position { position_of(handle) };
+
+        return (position == m_values.size()) ? nullptr : (m_values.data() + position);
+    }
+
+    const T* get(Handle handle) const noexcept
+    {
+        std::size_t position { position_of(handle) };
+
+        return (position == m_values.size()) ? nullptr : (m_values.data() + position);
+    }
+
+    // No check for stale handles
+    T& operator[](Handle handle) noexcept
+    {
+        return m_values[m_slots[handle.index].index];
+    }
+
+    const T& operator[](Handle handle) const noexcept
+    {
+        return m_values[m_slots[handle.index].index];
+    }
+
+    // It works the same as operator[] but it asserts if the handle is stale
+    T& at_checked(Handle handle)
+    {
+        std::size_t position { position_of(handle) };
+
+        BASIC_ASSERT((position != m_values.size()), "The handle is stale, its element was erased.\n");
+
+        return m_values[position];
+    }
+
+    const T& at_checked(Handle handle) const
+    {
+        std::size_t position { position_of(handle) };
+
+        BASIC_ASSERT((position != m_values.size()), "The handle is stale, its element was erased.\n");
+
+        return m_values[position];
+    }
+
+    // The handle of the element at "position" of the dense array, e.g. while iterating
+    Handle handle_at(std::size_t position) const
+    {
+        BASIC_ASSERT((position < m_values.size()), "The position must be a positive number and not bigger than the size of the SlotMap.\n");
+
+        std::uint32_t slot { m_value_to_slot[position] };
+
+        return Handle { slot, m_slots[slot].generation };
+    }
+
+    // It erases every element, so all the handles given so far become stale
+    void clear()
+    {
+        for (std::uint32_t slot : m_value_to_slot)
+        {
+            release_slot(slot);
+        }
+
+        m_values.destroy_all();
+        m_value_to_slot.destroy_all();
+    }
+
+    T* data() noexcept { return m_values.data(); }
+
+    const T* data() const noexcept { return m_values.data(); }
+
+    // The elements in their dense order, which changes when elements are erased
+    iterator begin() noexcept { return m_values.begin(); }
+
+    iterator end() noexcept { return m_values.end(); }
+
+    const_iterator begin() const noexcept { return m_values.begin(); }
+
+    const_iterator end() const noexcept { return m_values.end(); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+};
+
+} // namespace hdsa end
+
+#endif // SLOT_MAP_HPP
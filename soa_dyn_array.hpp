@@ -0,0 +1,694 @@
+#ifndef SOA_DYN_ARRAY_HPP
+#define SOA_DYN_ARRAY_HPP
+
+#include "dyn_array.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <iostream>
+#include <utility>
+#include <tuple>
+#include <span>
+
+/**
+ * Personal implementation of a "Structure of Arrays" Dynamic Array. Every field of a record lives
+ * in its own contiguous buffer, but all of them share the same size, capacity and growth policy
+ * (the same one as DynArray, growing by a factor of 2).
+ * It's useful when an algorithm only touches a few fields of every record, so the rest of them
+ * don't have to be pulled through the cache. Each field can be processed as a std::span, and
+ * the iterators give row-wise access through tuples of references.
+*/
+
+namespace hdsa
+{
+
+template<typename... Fields>
+class SoADynArray final
+{
+    static_assert((sizeof...(Fields) > 0), "A SoADynArray needs at least one field.");
+
+public:
+    using value_type = std::tuple<Fields...>;
+
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    // Rows don't exist in memory, so references to them are tuples of references to every field
+    using reference = std::tuple<Fields&...>;
+    using const_reference = std::tuple<const Fields&...>;
+
+    template<std::size_t I>
+    using field_type = std::tuple_element_t<I, value_type>;
+
+    static constexpr std::size_t field_count { sizeof...(Fields) };
+
+private:
+    std::tuple<Fields*...> m_buffers {};
+    std::size_t m_size {};
+    std::size_t m_capacity {};
+
+    using Indices = std::index_sequence_for<Fields...>;
+
+    struct ConstIterator;
+
+    struct Iterator final
+    {
+        using difference_type = std::ptrdiff_t;
+
+        using value_type = SoADynArray::value_type;
+
+        using reference = SoADynArray::reference;
+
+        // Proxy references can't satisfy the legacy forward iterator requirements
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
+
+    private:
+        SoADynArray* m_array { nullptr };
+        std::size_t m_index {};
+
+        friend struct ConstIterator;
+
+    public:
+        Iterator() = default;
+
+        Iterator(SoADynArray* array, std::size_t index)
+        : m_array { array },
+          m_index { index } {}
+
+        reference operator*() const
+        {
+            return (*m_array)[m_index];
+        }
+
+        reference operator[](const difference_type position) const
+        {
+            return (*m_array)[m_index + static_cast<std::size_t>(position)];
+        }
+
+        std::size_t index() const
+        {
+            return m_index;
+        }
+
+        Iterator& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator iterator { *this };
+            ++(*this);
+            return iterator;
+        }
+
+        Iterator& operator--()
+        {
+            --m_index;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator iterator { *this };
+            --(*this);
+            return iterator;
+        }
+
+        Iterator& operator+=(const difference_type x)
+        {
+            m_index += static_cast<std::size_t>(x);
+            return *this;
+        }
+
+        Iterator& operator-=(const difference_type x)
+        {
+            m_index -= static_cast<std::size_t>(x);
+            return *this;
+        }
+
+        Iterator operator+(const difference_type x) const
+        {
+            return Iterator { m_array, m_index + static_cast<std::size_t>(x) };
+        }
+
+        Iterator operator-(const difference_type x) const
+        {
+            return Iterator { m_array, m_index - static_cast<std::size_t>(x) };
+        }
+
+        friend Iterator operator+(const difference_type x, const Iterator& it)
+        {
+            return it + x;
+        }
+
+        difference_type operator-(const Iterator& other) const
+        {
+            return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index);
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& other)
+        {
+            return (a.m_index == other.m_index);
+        }
+
+        friend bool operator!=(const Iterator& a, const Iterator& other)
+        {
+            return (a.m_index != other.m_index);
+        }
+
+        friend bool operator<(const Iterator& a, const Iterator& other)
+        {
+            return (a.m_index < other.m_index);
+        }
+
+        friend bool operator>(const Iterator& a, const Iterator& other)
+        {
+            return (a.m_index > other.m_index);
+        }
+
+        friend bool operator<=(const Iterator& a, const Iterator& other)
+        {
+            return (a.m_index <= other.m_index);
+        }
+
+        friend bool operator>=(const Iterator& a, const Iterator& other)
+        {
+            return (a.m_index >= other.m_index);
+        }
+    };
+
+    struct ConstIterator final
+    {
+        using difference_type = std::ptrdiff_t;
+
+        using value_type = SoADynArray::value_type;
+
+        using reference = SoADynArray::const_reference;
+
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
+
+    private:
+        const SoADynArray* m_array { nullptr };
+        std::size_t m_index {};
+
+    public:
+        ConstIterator() = default;
+
+        ConstIterator(const SoADynArray* array, std::size_t index)
+        : m_array { array },
+          m_index { index } {}
+
+        ConstIterator(const Iterator& it)
+        : m_array { it.m_array },
+          m_index { it.index() } {}
+
+        reference operator*() const
+        {
+            return (*m_array)[m_index];
+        }
+
+        reference operator[](const difference_type position) const
+        {
+            return (*m_array)[m_index + static_cast<std::size_t>(position)];
+        }
+
+        std::size_t index() const
+        {
+            return m_index;
+        }
+
+        ConstIterator& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        ConstIterator operator++(int)
+        {
+            ConstIterator iterator { *this };
+            ++(*this);
+            return iterator;
+        }
+
+        ConstIterator& operator--()
+        {
+            --m_index;
+            return *this;
+        }
+
+        ConstIterator operator--(int)
+        {
+            ConstIterator iterator { *this };
+            --(*this);
+            return iterator;
+        }
+
+        ConstIterator& operator+=(const difference_type x)
+        {
+            m_index += static_cast<std::size_t>(x);
+            return *this;
+        }
+
+        ConstIterator& operator-=(const difference_type x)
+        {
+            m_index -= static_cast<std::size_t>(x);
+            return *this;
+        }
+
+        ConstIterator operator+(const difference_type x) const
+        {
+            return ConstIterator { m_array, m_index + static_cast<std::size_t>(x) };
+        }
+
+        ConstIterator operator-(const difference_type x) const
+        {
+            return ConstIterator { m_array, m_index - static_cast<std::size_t>(x) };
+        }
+
+        friend ConstIterator operator+(const difference_type x, const ConstIterator& it)
+        {
+            return it + x;
+        }
+
+        difference_type operator-(const ConstIterator& other) const
+        {
+            return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index);
+        }
+
+        friend bool operator==(const ConstIterator& a, const ConstIterator& other)
+        {
+            return (a.m_index == other.m_index);
+        }
+
+        friend bool operator!=(const ConstIterator& a, const ConstIterator& other)
+        {
+            return (a.m_index != other.m_index);
+        }
+
+        friend bool operator<(const ConstIterator& a, const ConstIterator& other)
+        {
+            return (a.m_index < other.m_index);
+        }
+
+        friend bool operator>(const ConstIterator& a, const ConstIterator& other)
+        {
+            return (a.m_index > other.m_index);
+        }
+
+        friend bool operator<=(const ConstIterator& a, const ConstIterator& other)
+        {
+            return (a.m_index <= other.m_index);
+        }
+
+        friend bool operator>=(const ConstIterator& a, const ConstIterator& other)
+        {
+            return (a.m_index >= other.m_index);
+        }
+    };
+
+public:
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+
+private:
+    // It moves the first "amount" elements of a single field into a new buffer of "new_capacity"
+    // elements, destroys the old ones and deallocates the old buffer
+    template<typename F>
+    static F* field_realloc(F* old_buffer, std::size_t old_size, std::size_t old_capacity, std::size_t new_capacity)
+    {
+        F* new_buffer { nullptr };
+
+        if (new_capacity > 0)
+        {
+            new_buffer = static_cast<F*>(::operator new(new_capacity * sizeof(F)));
+
+            std::size_t amount { (old_size < new_capacity) ? old_size : new_capacity };
+
+            for (std::size_t i {}; i < amount; i++)
+            {
+                new (new_buffer + i) F(std::move_if_noexcept(old_buffer[i]));
+            }
+        }
+
+        if (old_buffer != nullptr)
+        {
+            for (std::size_t i {}; i < old_size; i++)
+            {
+                old_buffer[i].~F();
+            }
+
+            ::operator delete(old_buffer, old_capacity * sizeof(F));
+        }
+
+        return new_buffer;
+    }
+
+    // All the fields are reallocated together, so they always keep the same capacity
+    template<std::size_t... I>
+    void mem_realloc_impl(std::size_t element_amount, std::index_sequence<I...>)
+    {
+        ((std::get<I>(m_buffers) = field_realloc(std::get<I>(m_buffers), m_size, m_capacity, element_amount)), ...);
+    }
+
+    void mem_realloc(std::size_t element_amount)
+    {
+        mem_realloc_impl(element_amount, Indices {});
+
+        m_capacity = element_amount;
+
+        if (m_size > m_capacity)
+        {
+            m_size = m_capacity;
+        }
+    }
+
+    // Same growth policy as DynArray
+    void grow_by_2()
+    {
+        if (m_capacity == 0)
+        {
+            mem_realloc(1);
+            return;
+        }
+
+        mem_realloc(m_capacity * 2);
+    }
+
+    template<std::size_t... I>
+    reference row(std::size_t position, std::index_sequence<I...>)
+    {
+        return reference { std::get<I>(m_buffers)[position]... };
+    }
+
+    template<std::size_t... I>
+    const_reference row(std::size_t position, std::index_sequence<I...>) const
+    {
+        return const_reference { std::get<I>(m_buffers)[position]... };
+    }
+
+    template<typename Tuple, std::size_t... I>
+    void construct_row(std::size_t position, Tuple&& t, std::index_sequence<I...>)
+    {
+        (new (std::get<I>(m_buffers) + position) Fields(std::get<I>(std::forward<Tuple>(t))), ...);
+    }
+
+    // The fields of "t" can refer to rows of this SoADynArray, which growing moves, so when it has to grow
+    // the new row is built before it
+    template<typename Tuple>
+    void construct_row_back(Tuple&& t)
+    {
+        BASIC_ASSERT((m_size < std::numeric_limits<std::size_t>::max()), "The SoADynArray has a number of rows that matches the limit of std::size_t, so new ones cannot be added.\n");
+
+        if (m_size == m_capacity)
+        {
+            value_type new_row { std::make_from_tuple<value_type>(std::forward<Tuple>(t)) };
+
+            grow_by_2();
+            construct_row(m_size, std::move(new_row), Indices {});
+        }
+        else
+        {
+            construct_row(m_size, std::forward<Tuple>(t), Indices {});
+        }
+
+        m_size++;
+    }
+
+    template<std::size_t... I>
+    void destroy_row(std::size_t position, std::index_sequence<I...>)
+    {
+        (std::get<I>(m_buffers)[position].~Fields(), ...);
+    }
+
+public:
+    SoADynArray() = default;
+
+    // It creates a SoADynArray with "size" number of rows made of default-initialized fields
+    explicit SoADynArray(std::size_t size)
+    {
+        resize(size);
+    }
+
+    SoADynArray(const SoADynArray& other)
+    {
+        reserve_memory(other.m_size);
+
+        for (std::size_t i {}; i < other.m_size; i++)
+        {
+            construct_row(i, other[i], Indices {});
+        }
+
+        m_size = other.m_size;
+    }
+
+    SoADynArray(SoADynArray&& other) noexcept
+    : m_buffers { std::exchange(other.m_buffers, std::tuple<Fields*...> {}) },
+      m_size { std::exchange(other.m_size, 0) },
+      m_capacity { std::exchange(other.m_capacity, 0) }
+    {}
+
+    SoADynArray& operator=(const SoADynArray& other)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        destroy_all();
+        reserve_memory(other.m_size);
+
+        for (std::size_t i {}; i < other.m_size; i++)
+        {
+            construct_row(i, other[i], Indices {});
+        }
+
+        m_size = other.m_size;
+
+        return *this;
+    }
+
+    SoADynArray& operator=(SoADynArray&& other) noexcept
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        reset_array();
+
+        m_buffers = std::exchange(other.m_buffers, std::tuple<Fields*...> {});
+        m_size = std::exchange(other.m_size, 0);
+        m_capacity = std::exchange(other.m_capacity, 0);
+
+        return *this;
+    }
+
+    ~SoADynArray()
+    {
+        reset_array();
+    }
+
+    // It calls the destructors for all the fields of every row and resets size back to 0.
+    // It doesn't deallocate the buffers
+    void destroy_all()
+    {
+        for (std::size_t i {}; i < m_size; i++)
+        {
+            destroy_row(i, Indices {});
+        }
+
+        m_size = 0;
+    }
+
+    bool is_empty() const noexcept { return (m_size == 0); }
+
+    bool is_full() const noexcept { return ((!is_empty()) && (m_size == m_capacity)); }
+
+    bool has_memory() const noexcept { return (m_capacity != 0); }
+
+    std::size_t size() const noexcept { return m_size; }
+
+    std::size_t capacity() const noexcept { return m_capacity; }
+
+    // The whole column of a single field, ready for vectorized processing
+    template<std::size_t I>
+    std::span<field_type<I>> field() noexcept
+    {
+        return std::span<field_type<I>> { std::get<I>(m_buffers), m_size };
+    }
+
+    template<std::size_t I>
+    std::span<const field_type<I>> field() const noexcept
+    {
+        return std::span<const field_type<I>> { std::get<I>(m_buffers), m_size };
+    }
+
+    reference operator[](std::size_t position)
+    {
+        return row(position, Indices {});
+    }
+
+    const_reference operator[](std::size_t position) const
+    {
+        return row(position, Indices {});
+    }
+
+    // It works the same as operator[] but it has bounds checking
+    reference at_checked(const std::size_t position)
+    {
+        BASIC_ASSERT((position < m_size), "The position must be a positive number and not bigger than the size of the SoADynArray.\n");
+
+        return row(position, Indices {});
+    }
+
+    const_reference at_checked(const std::size_t position) const
+    {
+        BASIC_ASSERT((position < m_size), "The position must be a positive number and not bigger than the size of the SoADynArray.\n");
+
+        return row(position, Indices {});
+    }
+
+    reference first()
+    {
+        BASIC_ASSERT(!is_empty(), "The SoADynArray is empty, you can't get the first row.\n");
+
+        return row(0, Indices {});
+    }
+
+    reference last()
+    {
+        BASIC_ASSERT(!is_empty(), "The SoADynArray is empty, you can't get the last row.\n");
+
+        return row(m_size - 1, Indices {});
+    }
+
+    // Increases the buffers and capacity
+    void reserve_memory(std::size_t element_amount)
+    {
+        if (element_amount <= m_capacity)
+        {
+            return;
+        }
+
+        mem_realloc(element_amount);
+    }
+
+    void push_back(const value_type& t)
+    {
+        construct_row_back(t);
+    }
+
+    void push_back(value_type&& t)
+    {
+        construct_row_back(std::move(t));
+    }
+
+    // Each argument constructs the field in the same position, so no tuple has to be made
+    template<typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        static_assert((sizeof...(Args) == sizeof...(Fields)), "emplace_back() needs exactly one argument per field.");
+
+        construct_row_back(std::forward_as_tuple(std::forward<Args>(args)...));
+
+        return row(m_size - 1, Indices {});
+    }
+
+    void pop_back()
+    {
+        if (is_empty())
+        {
+            std::cout << "The SoADynArray is already empty, no rows will be popped out.\n";
+            return;
+        }
+
+        m_size--;
+        destroy_row(m_size, Indices {});
+    }
+
+    // Changes the size of the SoADynArray and creates rows of default-constructed fields if element_amount
+    // is bigger than the current size. It will reallocate if element_ammount is bigger than the capacity
+    void resize(std::size_t element_amount)
+    {
+        if (m_capacity < element_amount)
+        {
+            mem_realloc(element_amount);
+        }
+
+        for (std::size_t i { m_size }; i < element_amount; i++)
+        {
+            construct_row(i, value_type {}, Indices {});
+        }
+
+        for (std::size_t i { element_amount }; i < m_size; i++)
+        {
+            destroy_row(i, Indices {});
+        }
+
+        m_size = element_amount;
+    }
+
+    // Makes a reallocation to use new smaller buffers just big enough to fit all the existing rows
+    void shrink_to_size()
+    {
+        if (m_size == m_capacity)
+        {
+            return;
+        }
+
+        mem_realloc(m_size);
+    }
+
+    // It destroys all the rows, sets size and capacity to 0, and deallocates all the buffers
+    void reset_array()
+    {
+        destroy_all();
+
+        if (has_memory())
+        {
+            mem_realloc(0);
+        }
+    }
+
+    iterator begin() noexcept
+    {
+        return iterator(this, 0);
+    }
+
+    iterator end() noexcept
+    {
+        return iterator(this, m_size);
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator(this, m_size);
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return const_iterator(this, m_size);
+    }
+};
+
+} // namespace hdsa end
+
+#endif // SOA_DYN_ARRAY_HPP
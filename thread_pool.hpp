@@ -0,0 +1,474 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include "dyn_array.hpp"
+#include "concurrent_queues.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Personal implementation of a work-stealing thread pool, meant to be the single scheduler behind
+ * every parallel algorithm of the library so they don't each start their own threads.
+ * Every worker has its own Chase-Lev deque: it pushes and pops jobs at the bottom without contention,
+ * while idle workers steal the oldest jobs from the top of the others, which are usually the biggest
+ * pieces of work. Threads that aren't workers submit jobs through a shared MpmcQueue.
+ * TaskGroup gives fork-join parallelism with spawn() and sync(). A thread waiting in sync() runs other
+ * jobs instead of blocking, so jobs can spawn and wait for more jobs (nested parallelism) without
+ * running out of threads. parallel_for() is built on top of it, splitting the range in halves until
+ * the pieces are small enough, so the chunks adapt to how much work every thread can take.
+*/
+
+namespace hdsa
+{
+
+class ThreadPool final
+{
+public:
+    // The type-erased unit of work. Whoever runs a job also deletes it
+    struct Job
+    {
+        virtual void execute() = 0;
+        virtual ~Job() = default;
+    };
+
+private:
+    // The deque from "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê, Pop, Cohen and
+    // Nardelli). Only the owner calls push() and pop(), any thread can call steal()
+    class WorkStealingDeque final
+    {
+    private:
+        struct Buffer final
+        {
+            std::int64_t capacity {};
+            std::int64_t mask {};
+            std::atomic<Job*>* jobs { nullptr };
+
+            explicit Buffer(std::int64_t buffer_capacity)
+            : capacity { buffer_capacity },
+              mask { buffer_capacity - 1 },
+              jobs { new std::atomic<Job*>[static_cast<std::size_t>(buffer_capacity)] } {}
+
+            ~Buffer()
+            {
+                delete[] jobs;
+            }
+
+            Job* get(std::int64_t index) const noexcept
+            {
+                return jobs[index & mask].load(std::memory_order_relaxed);
+            }
+
+            void put(std::int64_t index, Job* job) noexcept
+            {
+                jobs[index & mask].store(job, std::memory_order_relaxed);
+            }
+        };
+
+        alignas(cache_line_size) std::atomic<std::int64_t> m_top {};
+        alignas(cache_line_size) std::atomic<std::int64_t> m_bottom {};
+        std::atomic<Buffer*> m_buffer { nullptr };
+
+        // Thieves may still be reading an old buffer after a resize, so they're only deleted with the deque
+        SilentDynArray<std::unique_ptr<Buffer>> m_buffers {};
+
+        Buffer* grow(Buffer* buffer, std::int64_t bottom, std::int64_t top)
+        {
+            std::unique_ptr<Buffer> bigger { std::make_unique<Buffer>(buffer->capacity * 2) };
+
+            for (std::int64_t i { top }; i < bottom; i++)
+            {
+                bigger->put(i, buffer->get(i));
+            }
+
+            Buffer* raw { bigger.get() };
+
+            m_buffers.push_back(std::move(bigger));
+            m_buffer.store(raw, std::memory_order_release);
+
+            return raw;
+        }
+
+    public:
+        explicit WorkStealingDeque(std::int64_t capacity = 256)
+        {
+            m_buffers.push_back(std::make_unique<Buffer>(capacity));
+            m_buffer.store(m_buffers.last().get(), std::memory_order_relaxed);
+        }
+
+        WorkStealingDeque(const WorkStealingDeque& other) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque& other) = delete;
+
+        void push(Job* job)
+        {
+            std::int64_t bottom { m_bottom.load(std::memory_order_relaxed) };
+            std::int64_t top { m_top.load(std::memory_order_acquire) };
+            Buffer* buffer { m_buffer.load(std::memory_order_relaxed) };
+
+            if ((bottom - top) > (buffer->capacity - 1))
+            {
+                buffer = grow(buffer, bottom, top);
+            }
+
+            buffer->put(bottom, job);
+            m_bottom.store(bottom + 1, std::memory_order_release);
+        }
+
+        // It returns nullptr if the deque is empty
+        Job* pop()
+        {
+            std::int64_t bottom { m_bottom.load(std::memory_order_relaxed) - 1 };
+            Buffer* buffer { m_buffer.load(std::memory_order_relaxed) };
+
+            // Sequentially consistent, so the store can't be reordered after the load of m_top
+            m_bottom.store(bottom, std::memory_order_seq_cst);
+            std::int64_t top { m_top.load(std::memory_order_seq_cst) };
+
+            if (top > bottom)
+            {
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            Job* job { buffer->get(bottom) };
+
+            // The last job, so a thief may be taking it at the same time
+            if (top == bottom)
+            {
+                if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    job = nullptr;
+                }
+
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+
+            return job;
+        }
+
+        // It returns nullptr if the deque is empty or another thread took the job first
+        Job* steal()
+        {
+            std::int64_t top { m_top.load(std::memory_order_seq_cst) };
+            std::int64_t bottom { m_bottom.load(std::memory_order_seq_cst) };
+
+            if (top >= bottom)
+            {
+                return nullptr;
+            }
+
+            Job* job { m_buffer.load(std::memory_order_acquire)->get(top) };
+
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+
+            return job;
+        }
+    };
+
+    struct alignas(cache_line_size) Worker final
+    {
+        WorkStealingDeque deque {};
+        std::thread thread {};
+    };
+
+    // The worker that the current thread is, if it's one
+    struct WorkerContext final
+    {
+        ThreadPool* pool { nullptr };
+        std::size_t index {};
+    };
+
+    SilentDynArray<std::unique_ptr<Worker>> m_workers {};
+    MpmcQueue<Job*> m_injected { 1024 };        // Jobs submitted by threads that aren't workers
+
+    std::atomic<std::size_t> m_queued {};       // Jobs waiting to be picked up, to know when to wake up workers
+    std::atomic<std::size_t> m_sleeping {};
+    std::atomic<bool> m_stop { false };
+    std::mutex m_mutex {};
+    std::condition_variable m_wake_up {};
+
+    static WorkerContext& current_worker() noexcept
+    {
+        static thread_local WorkerContext context {};
+        return context;
+    }
+
+    bool is_own_worker() const noexcept
+    {
+        return (current_worker().pool == this);
+    }
+
+    void notify_workers()
+    {
+        if (m_sleeping.load(std::memory_order_seq_cst) > 0)
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+            m_wake_up.notify_one();
+        }
+    }
+
+    // It looks for a job in the own deque first (the newest job, still hot in cache), then in the shared
+    // queue, and at last it steals the oldest job of another worker
+    Job* find_job()
+    {
+        Job* job { nullptr };
+        std::size_t start {};
+
+        if (is_own_worker())
+        {
+            start = current_worker().index;
+            job = m_workers[start]->deque.pop();
+        }
+
+        if ((job == nullptr) && !m_injected.try_pop(job))
+        {
+            job = nullptr;
+        }
+
+        for (std::size_t i { 1 }; (job == nullptr) && (i <= m_workers.size()); i++)
+        {
+            job = m_workers[(start + i) % m_workers.size()]->deque.steal();
+        }
+
+        if (job != nullptr)
+        {
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        return job;
+    }
+
+    void worker_loop(std::size_t index)
+    {
+        current_worker() = WorkerContext { this, index };
+
+        while (true)
+        {
+            if (run_pending_job())
+            {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock { m_mutex };
+
+            m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+            m_wake_up.wait(lock, [this] { return m_stop.load() || (m_queued.load(std::memory_order_seq_cst) > 0); });
+            m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+
+            if (m_stop.load() && (m_queued.load() == 0))
+            {
+                return;
+            }
+        }
+    }
+
+    template<typename Function>
+    struct FunctionJob final : Job
+    {
+        Function function;
+        std::atomic<std::size_t>* pending;
+
+        FunctionJob(Function&& f, std::atomic<std::size_t>* pending_jobs)
+        : function { std::move(f) },
+          pending { pending_jobs } {}
+
+        void execute() override
+        {
+            function();
+
+            // After this the TaskGroup may be gone, so it's the last thing the job does with it
+            pending->fetch_sub(1, std::memory_order_release);
+        }
+    };
+
+public:
+    // A group of jobs that can be waited for together
+    class TaskGroup final
+    {
+    private:
+        ThreadPool& m_pool;
+        std::atomic<std::size_t> m_pending {};
+
+    public:
+        explicit TaskGroup(ThreadPool& pool)
+        : m_pool { pool } {}
+
+        TaskGroup(const TaskGroup& other) = delete;
+        TaskGroup& operator=(const TaskGroup& other) = delete;
+
+        ~TaskGroup()
+        {
+            sync();
+        }
+
+        template<typename Function>
+        void spawn(Function&& function)
+        {
+            m_pending.fetch_add(1, std::memory_order_relaxed);
+            m_pool.submit(new FunctionJob<std::decay_t<Function>> { std::decay_t<Function> { std::forward<Function>(function) }, &m_pending });
+        }
+
+        // It waits until every spawned job finishes, running pending jobs of the pool meanwhile
+        void sync()
+        {
+            while (m_pending.load(std::memory_order_acquire) != 0)
+            {
+                if (!m_pool.run_pending_job())
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    };
+
+    explicit ThreadPool(std::size_t thread_count = std::thread::hardware_concurrency())
+    {
+        if (thread_count == 0)
+        {
+            thread_count = 1;
+        }
+
+        m_workers.reserve_memory(thread_count);
+
+        for (std::size_t i {}; i < thread_count; i++)
+        {
+            m_workers.push_back(std::make_unique<Worker>());
+        }
+
+        // The threads start after every deque exists, since they steal from each other
+        for (std::size_t i {}; i < thread_count; i++)
+        {
+            m_workers[i]->thread = std::thread { &ThreadPool::worker_loop, this, i };
+        }
+    }
+
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+
+    // The jobs that are still queued are run before the workers stop
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+            m_stop.store(true);
+        }
+
+        m_wake_up.notify_all();
+
+        for (std::unique_ptr<Worker>& worker : m_workers)
+        {
+            worker->thread.join();
+        }
+    }
+
+    std::size_t thread_count() const noexcept { return m_workers.size(); }
+
+    // Workers push to their own deque, any other thread to the shared queue. When the shared queue is
+    // full the job just runs right away in the calling thread
+    void submit(Job* job)
+    {
+        m_queued.fetch_add(1, std::memory_order_seq_cst);
+
+        if (is_own_worker())
+        {
+            m_workers[current_worker().index]->deque.push(job);
+        }
+        else if (!m_injected.try_push(job))
+        {
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            job->execute();
+            delete job;
+
+            return;
+        }
+
+        notify_workers();
+    }
+
+    // It runs a single pending job in the calling thread, if there's any
+    bool run_pending_job()
+    {
+        Job* job { find_job() };
+
+        if (job == nullptr)
+        {
+            return false;
+        }
+
+        job->execute();
+        delete job;
+
+        return true;
+    }
+
+    // It calls "function" for every index of [first, last), either as function(i) or, when it takes two
+    // indices, as function(chunk_first, chunk_last) once per chunk. A "grain" of 0 picks a chunk size that
+    // gives every thread around 8 chunks, so the threads that finish early can steal some of the rest
+    template<typename Function>
+    void parallel_for(std::size_t first, std::size_t last, Function&& function, std::size_t grain = 0)
+    {
+        if (first >= last)
+        {
+            return;
+        }
+
+        if (grain == 0)
+        {
+            grain = (last - first) / (thread_count() * 8);
+            grain = (grain == 0) ? 1 : grain;
+        }
+
+        TaskGroup group { *this };
+
+        split_range(group, first, last, function, grain);
+        group.sync();
+    }
+
+private:
+    // The upper half of the range is spawned and the lower one is split again, so the biggest pieces are
+    // the first ones that other workers can steal
+    template<typename Function>
+    void split_range(TaskGroup& group, std::size_t first, std::size_t last, Function& function, std::size_t grain)
+    {
+        while ((last - first) > grain)
+        {
+            std::size_t middle { first + ((last - first) / 2) };
+
+            group.spawn([this, &group, &function, middle, last, grain] { split_range(group, middle, last, function, grain); });
+            last = middle;
+        }
+
+        if constexpr (std::is_invocable_v<Function&, std::size_t, std::size_t>)
+        {
+            function(first, last);
+        }
+        else
+        {
+            for (std::size_t i { first }; i < last; i++)
+            {
+                function(i);
+            }
+        }
+    }
+};
+
+// The pool shared by the parallel algorithms of the library, with a thread per hardware thread
+inline ThreadPool& default_thread_pool()
+{
+    static ThreadPool pool {};
+    return pool;
+}
+
+} // namespace hdsa end
+
+#endif // THREAD_POOL_HPP